@@ -1,15 +1,31 @@
 #ifndef COMPUTER_CLUB_CLIENT_HPP
 #define COMPUTER_CLUB_CLIENT_HPP
 
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <optional>
 
+#include "time_utils.hpp"
+
 namespace cc {
 
+    // Dense per-day client number, assigned by Club in order of first seating.
+    using ClientId = std::uint32_t;
+    inline constexpr ClientId kNoClient = std::numeric_limits<ClientId>::max();
+
     struct Client {
         std::string name;
         bool in_club = false;
         std::optional<std::size_t> table_id;  // nullopt if standing / waiting
+        std::optional<Time> waiting_since;    // set while in the waiting list
+    };
+
+    // One closed stay in the waiting list [from, to).
+    struct WaitInterval {
+        std::string client;
+        Time from{};
+        Time to{};
     };
 
 }  // namespace cc
@@ -1,45 +1,89 @@
 #ifndef COMPUTER_CLUB_CLUB_HPP
 #define COMPUTER_CLUB_CLUB_HPP
 
-#include <deque>
+#include <functional>
+#include <memory>
+#include <span>
 #include <unordered_map>
 
 #include "client.hpp"
 #include "parser.hpp"
+#include "scheduler.hpp"
 #include "table.hpp"
+#include "table_store.hpp"
 
 namespace cc {
 
     class Club {
     public:
-        explicit Club(const Config& cfg);
+        // Without a scheduler the waiting list is a FIFO bounded by the
+        // table count. Unlike the original queue, a client who leaves or is
+        // sent away gives up every slot they hold and is never seated later.
+        explicit Club(const Config& cfg,
+                      std::unique_ptr<Scheduler> scheduler = nullptr);
 
         // Process a chronological list of events, appending results to `log`.
+        // Equivalent to Open(), Process() for every event, then Close().
         void Run(const std::vector<IncomingEvent>& events,
                  std::vector<OutgoingEvent>& log);
 
-        // After Run() outputs per‑table stats.
-        [[nodiscard]] const std::vector<Table>& tables() const { return tables_; }
+        // Incremental interface for callers that receive events one by one.
+        void Open(std::vector<OutgoingEvent>& log);
+        // Returns false if the event was rejected without changing any state.
+        bool Process(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
+        // Drops remaining clients at close time and logs the closing line.
+        void Close(std::vector<OutgoingEvent>& log);
+
+        // Called after Open(), every Process() and Close() with the tables
+        // whose state changed since the previous call (0-based, each once).
+        using ChangeHook = std::function<void(const Club&, std::span<const std::size_t> changed)>;
+        void SetChangeHook(ChangeHook hook) { on_change_ = std::move(hook); }
+
+        // After Run() outputs per‑table stats. Materialised from the store
+        // on each call; use table_count() when only the size is needed.
+        [[nodiscard]] std::vector<Table> tables() const;
+        [[nodiscard]] std::size_t table_count() const { return store_.size(); }
+
+        // Raw table state, for readers that must not materialise tables().
+        [[nodiscard]] const TableStore& store() const { return store_; }
+        [[nodiscard]] const std::string& client_name(ClientId id) const { return names_[id]; }
+        [[nodiscard]] std::size_t queue_size() const { return scheduler_->size(); }
+
+        // Closed seating sessions and waiting-list stays, in closing order.
+        [[nodiscard]] const std::vector<Session>& sessions() const { return sessions_; }
+        [[nodiscard]] const std::vector<WaitInterval>& waits() const { return waits_; }
 
     private:
-        void HandleArrived(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
-        void HandleSeated(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
-        void HandleWaiting(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
-        void HandleLeft(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
+        bool HandleArrived(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
+        bool HandleSeated(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
+        bool HandleWaiting(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
+        bool HandleLeft(const IncomingEvent& ev, std::vector<OutgoingEvent>& log);
 
         void SeatClient(std::size_t table_idx, const std::string& name,
                         Time time, EventId outgoing_id,
                         std::vector<OutgoingEvent>& log,
                         bool emit_log = true);
 
-        void DropClient(const std::string& name, Time time,
+        // Bills the current occupant of `table_idx` and frees the table.
+        void ReleaseTable(std::size_t table_idx, Time time);
+        void EndWait(Client& client, Time time);
+        ClientId Intern(const std::string& name);
+        // Reports the store's dirty tables to the hook and clears them.
+        void NotifyChange();
+
+        bool DropClient(const std::string& name, Time time,
                         std::vector<OutgoingEvent>& log,
                         bool emit_left_event = true);
 
         Config cfg_;
-        std::vector<Table> tables_;
-        std::deque<std::string> queue_;  // FIFO waiting clients
+        TableStore store_;
+        std::unique_ptr<Scheduler> scheduler_;  // waiting clients
         std::unordered_map<std::string, Client> clients_;
+        std::vector<Session> sessions_;
+        std::vector<WaitInterval> waits_;
+        std::vector<std::string> names_;                // ClientId -> name
+        std::unordered_map<std::string, ClientId> ids_;  // name -> ClientId
+        ChangeHook on_change_;
     };
 
 }  // namespace cc
@@ -0,0 +1,33 @@
+#ifndef COMPUTER_CLUB_COMPACT_HPP
+#define COMPUTER_CLUB_COMPACT_HPP
+
+#include <ostream>
+#include <vector>
+
+#include "event.hpp"
+#include "parser.hpp"
+
+namespace cc {
+
+    enum class CompactMode : std::uint8_t {
+        // Replay yields the same per-table stats.
+        kStats,
+        // Additionally yields the same generated events (ID 11, 12) and the
+        // same echo of every retained incoming event.
+        kEvents,
+    };
+
+    // Runs the Club once and returns the subset of `events` that replays to
+    // an equivalent result. Always dropped: events rejected with an error
+    // and departures of clients who are not inside. kStats additionally
+    // drops every event of clients who were never seated nor queued.
+    std::vector<IncomingEvent> Compact(const Config& cfg,
+                                       const std::vector<IncomingEvent>& events,
+                                       CompactMode mode);
+
+    // Serialises `in` back into the input file format accepted by ParseFile.
+    void WriteInput(const ParsedInput& in, std::ostream& out);
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_COMPACT_HPP
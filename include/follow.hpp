@@ -0,0 +1,67 @@
+#ifndef COMPUTER_CLUB_FOLLOW_HPP
+#define COMPUTER_CLUB_FOLLOW_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "club.hpp"
+#include "parser.hpp"
+
+namespace cc {
+
+    // Tail-follows an append-only input file. Each Poll() reads only the
+    // bytes appended since the previous one, parses the complete lines
+    // among them and feeds them to a live Club, so the cost of a day is
+    // linear in its size. Line numbers in errors match ParseFile. After an
+    // exception the Follower must not be used again.
+    class Follower {
+    public:
+        // Throws std::runtime_error if the file cannot be opened.
+        explicit Follower(const std::filesystem::path& path);
+        ~Follower();
+
+        Follower(const Follower&) = delete;
+        Follower& operator=(const Follower&) = delete;
+
+        // Consumes newly appended complete lines, appending the resulting
+        // outgoing events to `log`. Returns true if any line was consumed.
+        // Throws ValidationError, or std::runtime_error if the file shrank.
+        bool Poll(std::vector<OutgoingEvent>& log);
+
+        // Consumes the rest of the file, including a final line without
+        // '\n', then closes the day: remaining clients are dropped.
+        void Finish(std::vector<OutgoingEvent>& log);
+
+        // Blocks until the file changes or `timeout` elapses. Uses inotify
+        // where available and plain sleeping otherwise.
+        void Wait(std::chrono::milliseconds timeout);
+
+        // Header is known once it has been read completely.
+        [[nodiscard]] const std::optional<Config>& config() const { return parser_.config(); }
+        // Valid once config() is set.
+        [[nodiscard]] const Club& club() const { return *club_; }
+        [[nodiscard]] bool finished() const { return finished_; }
+        // Bytes and lines consumed so far.
+        [[nodiscard]] std::uint64_t offset() const { return offset_; }
+        [[nodiscard]] std::size_t line_no() const { return parser_.line_no(); }
+
+    private:
+        // Feeds parsed events to the club, opening it once the header is read.
+        void Drain(std::vector<OutgoingEvent>& log);
+
+        std::string path_;
+        int fd_ = -1;
+        int notify_fd_ = -1;  // inotify instance, -1 if unavailable
+        std::uint64_t offset_ = 0;
+        StreamParser parser_;
+        std::optional<Club> club_;
+        bool finished_ = false;
+    };
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_FOLLOW_HPP
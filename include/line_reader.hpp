@@ -0,0 +1,77 @@
+#ifndef COMPUTER_CLUB_LINE_READER_HPP
+#define COMPUTER_CLUB_LINE_READER_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cc {
+
+    // Line-oriented file reader with a background read-ahead thread.
+    // Two fixed blocks are used alternately: the caller splits lines out of
+    // one while the worker thread fills the other, so disk I/O overlaps
+    // parsing. Pipes and FIFOs are read on the caller's thread instead, into
+    // a single block of at most kPipeBlockSize: a worker blocked in read()
+    // could not be stopped while the writer keeps its end open.
+    // Lines may straddle block boundaries. Semantics match std::getline:
+    // '\n' is stripped, a final unterminated line is returned.
+    class LineReader {
+    public:
+        static constexpr std::size_t kDefaultBlockSize = 1u << 20;  // 1 MiB
+        static constexpr std::size_t kPipeBlockSize = 1u << 16;     // 64 KiB
+
+        // Throws std::runtime_error if the file cannot be opened.
+        explicit LineReader(const std::filesystem::path& path,
+                            std::size_t block_size = kDefaultBlockSize);
+        ~LineReader();
+
+        LineReader(const LineReader&) = delete;
+        LineReader& operator=(const LineReader&) = delete;
+
+        // Reads the next line into `line`. Returns false at end of file.
+        // Throws std::runtime_error on I/O errors.
+        bool Next(std::string& line);
+
+        // 1-based number of the last line returned by Next().
+        [[nodiscard]] std::size_t line_no() const { return line_no_; }
+
+    private:
+        struct Block {
+            std::vector<char> data;
+            std::size_t size = 0;
+            bool filled = false;  // owned by consumer while true
+            bool eof = false;     // no data follows this block
+            int error = 0;        // errno of a failed read()
+        };
+
+        void Produce();
+        // Reads the next block on the caller's thread (non-regular files).
+        bool ReadInline();
+        // Hands the current block back to the worker and waits for the next
+        // one. Returns false once the file is exhausted.
+        bool Advance();
+
+        int fd_ = -1;
+        std::string path_;
+        std::array<Block, 2> blocks_;
+        std::size_t cur_ = 0;   // block being consumed
+        std::size_t pos_ = 0;   // read position within blocks_[cur_]
+        bool have_block_ = false;
+        bool done_ = false;
+        bool read_ahead_ = false;  // worker thread runs (regular files only)
+        std::size_t line_no_ = 0;
+
+        std::mutex mu_;
+        std::condition_variable cv_;
+        bool stop_ = false;
+        std::thread worker_;
+    };
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_LINE_READER_HPP
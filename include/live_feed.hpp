@@ -0,0 +1,69 @@
+#ifndef COMPUTER_CLUB_LIVE_FEED_HPP
+#define COMPUTER_CLUB_LIVE_FEED_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+#include "runtime.hpp"
+
+namespace cc {
+
+    // Feeds any number of inputs (regular files or FIFOs) into LiveClubs
+    // from one poll() loop on the calling thread. An input costs its fd
+    // and a StreamParser (its unfinished last line and parser state); the
+    // read buffer is shared. A club is spawned on the Runtime once its
+    // header is read.
+    class LiveFeed {
+    public:
+        // Called once per input, when its club is spawned.
+        using SinkFactory = std::function<EventSink(std::size_t input)>;
+
+        // Opens every input without waiting for FIFO writers. Inputs that
+        // cannot be opened are reported through error().
+        LiveFeed(Runtime& rt, const std::vector<std::filesystem::path>& paths,
+                 SinkFactory sinks);
+        ~LiveFeed();
+
+        LiveFeed(const LiveFeed&) = delete;
+        LiveFeed& operator=(const LiveFeed&) = delete;
+
+        // Reads until every input has ended or failed, closing each club at
+        // the end of its input. Does not wait for the clubs to drain.
+        void Run();
+
+        [[nodiscard]] std::size_t size() const { return inputs_.size(); }
+        // nullptr while the input's header is incomplete.
+        [[nodiscard]] LiveClub* club(std::size_t input) const { return inputs_[input].club; }
+        // Open, read or parse error of the input; empty if none.
+        [[nodiscard]] const std::string& error(std::size_t input) const {
+            return inputs_[input].error;
+        }
+
+    private:
+        struct Input {
+            std::string path;
+            int fd = -1;  // -1 once ended or failed
+            StreamParser parser;
+            LiveClub* club = nullptr;
+            std::string error;
+        };
+
+        // One read() worth of input; throws on parse errors.
+        void Read(std::size_t idx, std::string& chunk);
+        // Pushes parsed events, spawning the club once the header is read.
+        void Drain(std::size_t idx);
+        // Stops reading the input and closes its club.
+        void End(Input& in);
+
+        Runtime& rt_;
+        SinkFactory sinks_;
+        std::vector<Input> inputs_;
+    };
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_LIVE_FEED_HPP
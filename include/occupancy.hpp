@@ -0,0 +1,66 @@
+#ifndef COMPUTER_CLUB_OCCUPANCY_HPP
+#define COMPUTER_CLUB_OCCUPANCY_HPP
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "client.hpp"
+#include "table.hpp"
+#include "time_utils.hpp"
+
+namespace cc {
+
+    class Club;
+
+    // Read-only occupancy index over a simulated day. Since Time is bounded
+    // to 1440 minutes, busy tables are kept as one bitset per minute; the
+    // waiting-list length is a per-minute counter. Intervals are [from, to).
+    class OccupancyIndex {
+    public:
+        static constexpr std::size_t kMinutes = 24 * 60;
+
+        OccupancyIndex(std::size_t table_count, std::vector<Session> sessions,
+                       std::vector<WaitInterval> waits);
+        // Builds the index from a Club after Run()/Close().
+        explicit OccupancyIndex(const Club& club);
+
+        [[nodiscard]] std::size_t table_count() const { return table_count_; }
+
+        // Point queries. `table_id` is 1‑based.
+        [[nodiscard]] bool IsBusy(std::size_t table_id, Time t) const;
+        [[nodiscard]] std::optional<std::string> OccupantAt(std::size_t table_id,
+                                                            Time t) const;
+        [[nodiscard]] std::size_t BusyCount(Time t) const;
+        // (table_id, client) pairs ordered by table.
+        [[nodiscard]] std::vector<std::pair<std::size_t, std::string>> BusyAt(Time t) const;
+        [[nodiscard]] std::size_t WaitingAt(Time t) const;
+
+        // Range queries over [from, to).
+        [[nodiscard]] std::vector<std::size_t> TablesBusyDuring(Time from, Time to) const;
+        [[nodiscard]] std::size_t MaxWaiting(Time from, Time to) const;
+
+        // Plain-text serialisation. Load() throws std::runtime_error.
+        void Save(std::ostream& out) const;
+        static OccupancyIndex Load(std::istream& in);
+
+    private:
+        [[nodiscard]] const std::uint64_t* Row(Time t) const {
+            return busy_.data() + std::size_t{t.minutes()} * words_;
+        }
+
+        std::size_t table_count_;
+        std::size_t words_;                      // bitset words per minute
+        std::vector<std::uint64_t> busy_;        // kMinutes rows of words_
+        std::vector<std::vector<Session>> by_table_;  // sorted by `from`
+        std::vector<std::uint32_t> waiting_;     // per-minute queue length
+        std::vector<WaitInterval> waits_;
+    };
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_OCCUPANCY_HPP
@@ -2,6 +2,9 @@
 #define COMPUTER_CLUB_PARSER_HPP
 
 #include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "event.hpp"
@@ -29,6 +32,46 @@ namespace cc {
 
     ParsedInput ParseFile(const std::filesystem::path& path);
 
+    // Incremental parser behind ParseFile and the live readers (task follow,
+    // task live). Input arrives in arbitrary chunks through Feed(); Next()
+    // parses the complete lines and yields one event at a time once the
+    // header is read. Only the unconsumed tail is buffered. Line numbers in
+    // errors match ParseFile. After an exception it must not be used again.
+    class StreamParser {
+    public:
+        // Appends raw input; lines may be split anywhere.
+        void Feed(std::string_view bytes);
+        // End of input: a final line without '\n' becomes complete, and
+        // Next() reports a missing header.
+        void Finish();
+
+        // Parses up to the next event. Returns false when more input is
+        // needed, or once everything is consumed after Finish().
+        // Throws ValidationError.
+        bool Next(IncomingEvent& ev);
+
+        // Parses one whole line (without '\n') for callers that split lines
+        // themselves. Returns true if it was an event. Throws ValidationError.
+        bool ParseLine(const std::string& line, IncomingEvent& ev);
+
+        // Set once the header has been read completely.
+        [[nodiscard]] const std::optional<Config>& config() const { return cfg_; }
+        // Lines consumed so far.
+        [[nodiscard]] std::size_t line_no() const { return line_no_; }
+
+    private:
+        std::string buf_;      // input not yet consumed starts at pos_
+        std::size_t pos_ = 0;
+        std::string line_;
+        bool finished_ = false;
+        std::size_t line_no_ = 0;
+
+        Config header_;
+        std::size_t header_lines_ = 0;
+        std::optional<Config> cfg_;
+        Time last_time_{0};
+    };
+
 }  // namespace cc
 
 #endif  // COMPUTER_CLUB_PARSER_HPP
\ No newline at end of file
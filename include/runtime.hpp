@@ -0,0 +1,113 @@
+#ifndef COMPUTER_CLUB_RUNTIME_HPP
+#define COMPUTER_CLUB_RUNTIME_HPP
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "club.hpp"
+
+namespace cc {
+
+    class Runtime;
+
+    // Receives a club's outgoing events, in order. Called on pool threads,
+    // never concurrently for the same club.
+    using EventSink = std::function<void(const OutgoingEvent&)>;
+
+    // One live club: a mailbox for incoming events plus the coroutine that
+    // drains it. Producers Push() events in chronological order and Close()
+    // at the end of the day; the club then drains and frees its state.
+    class LiveClub {
+    public:
+        LiveClub(const LiveClub&) = delete;
+        LiveClub& operator=(const LiveClub&) = delete;
+
+        // Thread-safe. Throws std::logic_error after Close() or a failure.
+        void Push(IncomingEvent ev);
+        void Close();
+
+        // Valid once the club has finished (e.g. after Runtime::Wait()).
+        [[nodiscard]] const std::vector<Table>& tables() const { return tables_; }
+        // Exception thrown by the simulation or the sink, if any.
+        [[nodiscard]] std::exception_ptr error() const { return error_; }
+
+    private:
+        friend class Runtime;
+
+        // Awaited by the club coroutine; nullopt once closed and drained.
+        struct NextEvent {
+            LiveClub& club;
+            bool await_ready();
+            bool await_suspend(std::coroutine_handle<> h);
+            std::optional<IncomingEvent> await_resume();
+        };
+
+        LiveClub(Runtime& rt, const Config& cfg, EventSink sink,
+                 std::unique_ptr<Scheduler> scheduler);
+
+        NextEvent Next() { return NextEvent{*this}; }
+
+        Runtime& rt_;
+        std::unique_ptr<Club> club_;  // released once the day is closed
+        EventSink sink_;
+        std::vector<Table> tables_;
+        std::exception_ptr error_;
+
+        std::mutex mu_;
+        std::deque<IncomingEvent> pending_;
+        bool closed_ = false;
+        std::coroutine_handle<> waiter_;  // set while suspended in Next()
+    };
+
+    // Runs any number of LiveClubs as C++20 coroutines on a fixed thread
+    // pool. A club only occupies a thread while it has events to process;
+    // an idle club costs its coroutine frame, Club state and mailbox.
+    class Runtime {
+    public:
+        explicit Runtime(std::size_t threads = std::thread::hardware_concurrency());
+        // Closes every club, waits for them and stops the pool.
+        ~Runtime();
+
+        Runtime(const Runtime&) = delete;
+        Runtime& operator=(const Runtime&) = delete;
+
+        // Thread-safe. The returned reference lives as long as the Runtime.
+        LiveClub& Spawn(const Config& cfg, EventSink sink,
+                        std::unique_ptr<Scheduler> scheduler = nullptr);
+
+        // Blocks until every spawned club has been closed and drained.
+        void Wait();
+
+    private:
+        friend class LiveClub;
+        struct Task;
+        struct Yield;
+
+        static Task Drive(LiveClub& lc);
+
+        void Schedule(std::coroutine_handle<> h);
+        void Finished();
+        void Work();
+
+        std::mutex mu_;
+        std::condition_variable ready_cv_;
+        std::condition_variable idle_cv_;
+        std::deque<std::coroutine_handle<>> ready_;
+        std::list<std::unique_ptr<LiveClub>> clubs_;
+        std::size_t active_ = 0;
+        bool stop_ = false;
+        std::vector<std::thread> workers_;
+    };
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_RUNTIME_HPP
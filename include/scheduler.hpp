@@ -0,0 +1,128 @@
+#ifndef COMPUTER_CLUB_SCHEDULER_HPP
+#define COMPUTER_CLUB_SCHEDULER_HPP
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cc {
+
+    // Waiting-list policy: who may queue and who gets a freed table.
+    class Scheduler {
+    public:
+        virtual ~Scheduler() = default;
+
+        // Queues `name`. Returns false on overflow (the client must leave).
+        // Whether a client who already waits takes another slot is up to
+        // the policy.
+        virtual bool Enqueue(const std::string& name) = 0;
+        // Removes a waiting client (every slot they hold); no-op if `name`
+        // is not queued.
+        virtual void Remove(const std::string& name) = 0;
+        // Dequeues the client to seat at the freed table `table_idx` (0-based).
+        virtual std::optional<std::string> Next(std::size_t table_idx) = 0;
+
+        [[nodiscard]] virtual bool Contains(const std::string& name) const = 0;
+        [[nodiscard]] virtual std::size_t size() const = 0;
+    };
+
+    // Plain FIFO bounded by `capacity` (the table count by default). As in
+    // the original queue, every Enqueue() takes a slot: a client who waits
+    // twice holds two and may be seated from either.
+    class FifoScheduler final : public Scheduler {
+    public:
+        explicit FifoScheduler(std::size_t capacity) : capacity_(capacity) {}
+
+        bool Enqueue(const std::string& name) override;
+        void Remove(const std::string& name) override;
+        std::optional<std::string> Next(std::size_t table_idx) override;
+
+        [[nodiscard]] bool Contains(const std::string& name) const override {
+            return index_.contains(name);
+        }
+        [[nodiscard]] std::size_t size() const override { return queue_.size(); }
+
+    private:
+        std::size_t capacity_;
+        std::list<std::string> queue_;
+        std::unordered_multimap<std::string, std::list<std::string>::iterator> index_;
+    };
+
+    // Higher tier first (e.g. VIP), FIFO within a tier. Indexed binary heap,
+    // so removal of an arbitrary client is O(log n). Unlisted clients: tier 0.
+    // A client who already waits keeps their slot.
+    class PriorityScheduler final : public Scheduler {
+    public:
+        PriorityScheduler(std::size_t capacity,
+                          std::unordered_map<std::string, std::uint32_t> tiers)
+            : capacity_(capacity), tiers_(std::move(tiers)) {}
+
+        bool Enqueue(const std::string& name) override;
+        void Remove(const std::string& name) override;
+        std::optional<std::string> Next(std::size_t table_idx) override;
+
+        [[nodiscard]] bool Contains(const std::string& name) const override {
+            return pos_.contains(name);
+        }
+        [[nodiscard]] std::size_t size() const override { return heap_.size(); }
+
+    private:
+        struct Entry {
+            std::string name;
+            std::uint32_t tier = 0;
+            std::uint64_t seq = 0;
+        };
+
+        [[nodiscard]] bool Before(std::size_t a, std::size_t b) const;
+        void Swap(std::size_t a, std::size_t b);
+        void SiftUp(std::size_t i);
+        void SiftDown(std::size_t i);
+
+        std::size_t capacity_;
+        std::unordered_map<std::string, std::uint32_t> tiers_;
+        std::vector<Entry> heap_;
+        std::unordered_map<std::string, std::size_t> pos_;  // name -> heap slot
+        std::uint64_t next_seq_ = 0;
+    };
+
+    // Tables are grouped into zones; a client with a zone preference only
+    // takes tables of that zone, others take any. One FIFO per zone plus a
+    // shared one; a freed table goes to the earliest of the two candidates.
+    // A client who already waits keeps their slot.
+    class ZoneScheduler final : public Scheduler {
+    public:
+        // `table_zone[i]` is the zone of table i (0-based), zones are 0..N-1.
+        ZoneScheduler(std::size_t capacity, std::vector<std::size_t> table_zone,
+                      std::unordered_map<std::string, std::size_t> client_zone);
+
+        bool Enqueue(const std::string& name) override;
+        void Remove(const std::string& name) override;
+        std::optional<std::string> Next(std::size_t table_idx) override;
+
+        [[nodiscard]] bool Contains(const std::string& name) const override {
+            return index_.contains(name);
+        }
+        [[nodiscard]] std::size_t size() const override { return index_.size(); }
+
+    private:
+        struct Waiting {
+            std::string name;
+            std::uint64_t seq = 0;
+        };
+        using Queue = std::list<Waiting>;
+
+        std::size_t capacity_;
+        std::vector<std::size_t> table_zone_;
+        std::unordered_map<std::string, std::size_t> client_zone_;
+        std::vector<Queue> queues_;  // one per zone, the last one is "any"
+        std::unordered_map<std::string, std::pair<std::size_t, Queue::iterator>> index_;
+        std::uint64_t next_seq_ = 0;
+    };
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_SCHEDULER_HPP
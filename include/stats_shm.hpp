@@ -0,0 +1,90 @@
+#ifndef COMPUTER_CLUB_STATS_SHM_HPP
+#define COMPUTER_CLUB_STATS_SHM_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "table.hpp"
+
+namespace cc {
+
+    class Club;
+
+    // Live per-table state published through POSIX shared memory.
+    //
+    // The segment holds a header and one fixed-size record per table, all
+    // made of 64-bit words, guarded by a seqlock: the single writer makes
+    // the sequence odd, updates the words and makes it even again; readers
+    // retry while it is odd or has changed under them. Readers never block
+    // the writer and any number of processes may read concurrently.
+    //
+    // Occupant names are stored in kMaxName bytes and truncated beyond.
+
+    struct StatsSnapshot {
+        std::uint64_t version = 0;      // number of Publish() calls so far
+        std::size_t queue_length = 0;
+        std::vector<Table> tables;
+    };
+
+    class StatsPublisher {
+    public:
+        static constexpr std::size_t kMaxName = 32;
+
+        // Creates a fresh segment `name` ("/club" or "club"), replacing an
+        // existing one. Throws std::runtime_error on failure.
+        StatsPublisher(const std::string& name, std::size_t table_count);
+        // Unmaps only: the last published state stays readable until
+        // Remove() so dashboards can still show a finished day.
+        ~StatsPublisher();
+
+        StatsPublisher(const StatsPublisher&) = delete;
+        StatsPublisher& operator=(const StatsPublisher&) = delete;
+
+        void Publish(const Club& club);
+        // Rewrites only the `changed` tables (0-based) and the queue length;
+        // the rest of the segment must already match the club. Fits
+        // Club::ChangeHook.
+        void Publish(const Club& club, std::span<const std::size_t> changed);
+        void Publish(const std::vector<Table>& tables, std::size_t queue_length);
+
+        // Unlinks segment `name`; false if it did not exist.
+        static bool Remove(const std::string& name);
+
+    private:
+        void Begin();
+        void End();
+        void WriteTable(std::size_t idx, bool busy, const std::string* occupant,
+                        Time since, std::uint32_t revenue, std::uint32_t busy_minutes);
+        void WriteTable(const Club& club, std::size_t idx);
+
+        std::uint64_t* base_ = nullptr;
+        std::size_t bytes_ = 0;
+        std::size_t table_count_ = 0;
+    };
+
+    class StatsReader {
+    public:
+        // Maps segment `name` read-only. Throws std::runtime_error.
+        explicit StatsReader(const std::string& name);
+        ~StatsReader();
+
+        StatsReader(const StatsReader&) = delete;
+        StatsReader& operator=(const StatsReader&) = delete;
+
+        // Single attempt; nullopt if a write was in progress.
+        [[nodiscard]] std::optional<StatsSnapshot> TryRead() const;
+        // Retries until a consistent snapshot is taken.
+        [[nodiscard]] StatsSnapshot Read() const;
+
+    private:
+        std::uint64_t* base_ = nullptr;
+        std::size_t bytes_ = 0;
+        std::size_t table_count_ = 0;
+    };
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_STATS_SHM_HPP
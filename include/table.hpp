@@ -19,6 +19,14 @@ namespace cc {
         [[nodiscard]] bool IsBusy() const { return occupant.has_value(); }
     };
 
+    // One closed seating interval [from, to) at a table.
+    struct Session {
+        std::size_t table_id = 0;  // 1‑based
+        std::string client;
+        Time from{};
+        Time to{};
+    };
+
 }  // namespace cc
 
 #endif  // COMPUTER_CLUB_TABLE_HPP
\ No newline at end of file
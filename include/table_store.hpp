@@ -0,0 +1,59 @@
+#ifndef COMPUTER_CLUB_TABLE_STORE_HPP
+#define COMPUTER_CLUB_TABLE_STORE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "client.hpp"
+#include "time_utils.hpp"
+
+namespace cc {
+
+    // Struct-of-arrays table storage. Hot state (busy bitmap, occupant ids,
+    // since-times) is kept apart from the cold per-day stats, so busy checks
+    // touch one bit per table and no strings at all, and "is any table
+    // free" is a counter compare. Indices are 0‑based; `Table` remains the
+    // per-table view for callers.
+    class TableStore {
+    public:
+        explicit TableStore(std::size_t count);
+
+        [[nodiscard]] std::size_t size() const { return occupant_.size(); }
+
+        [[nodiscard]] bool IsBusy(const std::size_t idx) const {
+            return (busy_[idx / 64] >> (idx % 64)) & 1u;
+        }
+        [[nodiscard]] bool HasFree() const { return busy_count_ < size(); }
+
+        [[nodiscard]] ClientId occupant(const std::size_t idx) const { return occupant_[idx]; }
+        [[nodiscard]] Time since(const std::size_t idx) const { return since_[idx]; }
+        [[nodiscard]] std::uint32_t revenue(const std::size_t idx) const { return revenue_[idx]; }
+        [[nodiscard]] std::uint32_t busy_minutes(const std::size_t idx) const {
+            return busy_minutes_[idx];
+        }
+
+        void Occupy(std::size_t idx, ClientId client, Time time);
+        // Frees a busy table and bills the session. Returns its length.
+        std::uint16_t Release(std::size_t idx, Time time, std::uint32_t hourly_price);
+
+        // Tables changed by Occupy()/Release() since the last ClearDirty(),
+        // each listed once, so observers can skip the unchanged ones.
+        [[nodiscard]] const std::vector<std::size_t>& dirty() const { return dirty_; }
+        void ClearDirty();
+
+    private:
+        void MarkDirty(std::size_t idx);
+
+        std::vector<std::uint64_t> busy_;    // bitmap, one bit per table
+        std::vector<ClientId> occupant_;     // kNoClient if free
+        std::vector<Time> since_;            // valid only if busy
+        std::vector<std::uint32_t> revenue_;
+        std::vector<std::uint32_t> busy_minutes_;
+        std::size_t busy_count_ = 0;
+        std::vector<std::size_t> dirty_;
+        std::vector<std::uint64_t> dirty_bits_;  // bitmap over dirty_
+    };
+
+}  // namespace cc
+
+#endif  // COMPUTER_CLUB_TABLE_STORE_HPP
@@ -16,39 +16,71 @@ constexpr std::string_view kErrICanWaitNoLonger = "ICanWaitNoLonger!";
 
 }  // namespace
 
-Club::Club(const Config& cfg) : cfg_(cfg) {
-  tables_.resize(cfg_.table_count);
-  for (std::size_t i = 0; i < cfg_.table_count; ++i) {
-    tables_[i].id = i + 1;  // 1‑based
+Club::Club(const Config& cfg, std::unique_ptr<Scheduler> scheduler)
+    : cfg_(cfg), store_(cfg.table_count), scheduler_(std::move(scheduler)) {
+  if (!scheduler_) scheduler_ = std::make_unique<FifoScheduler>(cfg_.table_count);
+}
+
+std::vector<Table> Club::tables() const {
+  std::vector<Table> out(store_.size());
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    Table& t = out[i];
+    t.id = i + 1;  // 1‑based
+    if (store_.IsBusy(i)) {
+      t.occupant = names_[store_.occupant(i)];
+      t.occupied_since = store_.since(i);
+    }
+    t.revenue = store_.revenue(i);
+    t.busy_minutes = store_.busy_minutes(i);
   }
+  return out;
+}
+
+ClientId Club::Intern(const std::string& name) {
+  const auto [it, inserted] = ids_.try_emplace(name, static_cast<ClientId>(names_.size()));
+  if (inserted) names_.push_back(name);
+  return it->second;
 }
 
 void Club::Run(const std::vector<IncomingEvent>& events,
                std::vector<OutgoingEvent>& log) {
   log.reserve(events.size() * 2 + 32);
 
+  Open(log);
+  for (const auto& ev : events) Process(ev, log);
+  Close(log);
+}
+
+void Club::Open(std::vector<OutgoingEvent>& log) {
   log.push_back({cfg_.open_time, EventId::kError, ""});
+  NotifyChange();
+}
 
-  for (const auto& ev : events) {
-    switch (ev.id) {
-      case EventId::kClientArrived:
-        HandleArrived(ev, log);
-        break;
-      case EventId::kClientSeated:
-        HandleSeated(ev, log);
-        break;
-      case EventId::kClientWaiting:
-        HandleWaiting(ev, log);
-        break;
-      case EventId::kClientLeft:
-        HandleLeft(ev, log);
-        break;
-      default:
-        // For unknown IDs we just log error could extend.
-        log.push_back({ev.time, EventId::kError, "BadEventId"});
-    }
-  }
+bool Club::Process(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
+  bool accepted = false;
+  switch (ev.id) {
+    case EventId::kClientArrived:
+      accepted = HandleArrived(ev, log);
+      break;
+    case EventId::kClientSeated:
+      accepted = HandleSeated(ev, log);
+      break;
+    case EventId::kClientWaiting:
+      accepted = HandleWaiting(ev, log);
+      break;
+    case EventId::kClientLeft:
+      accepted = HandleLeft(ev, log);
+      break;
+    default:
+      // For unknown IDs we just log error could extend.
+      log.push_back({ev.time, EventId::kError, "BadEventId"});
+      break;
+  }
+  NotifyChange();
+  return accepted;
+}
 
+void Club::Close(std::vector<OutgoingEvent>& log) {
   // Closing time: drop remaining seated/standing clients alphabetically.
   std::vector<std::string> still_inside;
   for (const auto& [name, cl] : clients_) {
@@ -61,131 +93,143 @@ void Club::Run(const std::vector<IncomingEvent>& events,
 
   // Club closed.
   log.push_back({cfg_.close_time, EventId::kError, ""});
+  NotifyChange();
+}
+
+void Club::NotifyChange() {
+  if (!on_change_) return;
+  on_change_(*this, store_.dirty());
+  store_.ClearDirty();
 }
 
-void Club::HandleArrived(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
+bool Club::HandleArrived(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
   log.push_back({ev.time, ev.id, ev.payload[0]});
   const auto& name = ev.payload[0];
   if (ev.time < cfg_.open_time || ev.time >= cfg_.close_time) {
     log.push_back({ev.time, EventId::kError, std::string(kErrNotOpenYet)});
-    return;
+    return false;
   }
   auto& client = clients_[name];
   if (client.in_club) {
     log.push_back({ev.time, EventId::kError, std::string(kErrYouShallNotPass)});
-    return;
+    return false;
   }
   client.name = name;
   client.in_club = true;
+  return true;
 }
 
 void Club::SeatClient(std::size_t table_idx, const std::string& name,
                       const Time time, const EventId outgoing_id,
                       std::vector<OutgoingEvent>& log,
                       bool emit_log) {
-  Table& table = tables_[table_idx];
-  table.occupant = name;
-  table.occupied_since = time;
-  clients_[name].table_id = table_idx;
+  Client& client = clients_[name];
+  // A seated client moves: whether they asked to or were queued while
+  // seated, the old table is billed and freed first.
+  if (client.table_id) ReleaseTable(*client.table_id, time);
+  store_.Occupy(table_idx, Intern(name), time);
+  client.table_id = table_idx;
+  // A waiting client may also take a free table on their own.
+  scheduler_->Remove(name);
+  EndWait(client, time);
   if (emit_log) {                                   // ← новое условие
     std::ostringstream oss;
-    oss << name << ' ' << table.id;
+    oss << name << ' ' << table_idx + 1;
     log.push_back({time, outgoing_id, oss.str()});
   }
 }
 
-void Club::HandleSeated(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
+bool Club::HandleSeated(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
   log.push_back({ev.time, ev.id, ev.payload[0] + ' ' + ev.payload[1]});
   const auto& name = ev.payload[0];
   const std::size_t table_no = std::stoul(ev.payload[1]);
-  if (table_no == 0 || table_no > tables_.size()) {
+  if (table_no == 0 || table_no > store_.size()) {
     log.push_back({ev.time, EventId::kError, "BadTable"});
-    return;
+    return false;
   }
-  const Table& table = tables_[table_no - 1];
 
   auto it = clients_.find(name);
   if (it == clients_.end() || !it->second.in_club) {
     log.push_back({ev.time, EventId::kError, std::string(kErrClientUnknown)});
-    return;
-  }
-  const Client& client = it->second;
-
-  if (table.IsBusy() && table.occupant != name) {
-    log.push_back({ev.time, EventId::kError, std::string(kErrPlaceIsBusy)});
-    return;
+    return false;
   }
-
-  if (table.occupant == name) {
+  // Busy by someone else or by the client themselves.
+  if (store_.IsBusy(table_no - 1)) {
     log.push_back({ev.time, EventId::kError, std::string(kErrPlaceIsBusy)});
-    return;
-  }
-
-  if (client.table_id) {
-    Table& old_table = tables_[*client.table_id];
-    const auto minutes = ev.time - old_table.occupied_since;
-    old_table.busy_minutes += minutes;
-    old_table.revenue += cfg_.hourly_price * MinutesToHoursRounded(minutes);
-    old_table.occupant.reset();
+    return false;
   }
 
   SeatClient(table_no - 1, name, ev.time, EventId::kClientSeated, log, false);
+  return true;
 }
 
-void Club::HandleWaiting(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
+bool Club::HandleWaiting(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
   log.push_back({ev.time, ev.id, ev.payload[0]});
   const auto& name = ev.payload[0];
   auto it = clients_.find(name);
   if (it == clients_.end() || !it->second.in_club) {
     log.push_back({ev.time, EventId::kError, std::string(kErrClientUnknown)});
-    return;
+    return false;
   }
-  for (const auto& t : tables_) {
-    if (!t.IsBusy()) {
-      log.push_back({ev.time, EventId::kError, std::string(kErrICanWaitNoLonger)});
-      return;
-    }
+  if (store_.HasFree()) {
+    log.push_back({ev.time, EventId::kError, std::string(kErrICanWaitNoLonger)});
+    return false;
   }
 
-  if (queue_.size() >= tables_.size()) {
-    // Queue overflow – client goes away.
-    log.push_back({ev.time, EventId::kOutgoingLeft, name});
+  if (!scheduler_->Enqueue(name)) {
+    // Queue overflow – client goes away like one who leaves: any slot and
+    // table they hold are given up, the table is billed and handed on.
+    DropClient(name, ev.time, log);
     clients_.erase(name);
-    return;
+    return true;
   }
+  if (!it->second.waiting_since) it->second.waiting_since = ev.time;
+  return true;
+}
 
-  queue_.push_back(name);
+void Club::ReleaseTable(const std::size_t table_idx, const Time time) {
+  const ClientId who = store_.occupant(table_idx);
+  const Time since = store_.since(table_idx);
+  store_.Release(table_idx, time, cfg_.hourly_price);
+  sessions_.push_back({table_idx + 1, names_[who], since, time});
 }
 
-void Club::DropClient(const std::string& name, Time time,
+void Club::EndWait(Client& client, const Time time) {
+  if (!client.waiting_since) return;
+  waits_.push_back({client.name, *client.waiting_since, time});
+  client.waiting_since.reset();
+}
+
+bool Club::DropClient(const std::string& name, Time time,
                       std::vector<OutgoingEvent>& log,
                       bool emit_left_event) {
   const auto it = clients_.find(name);
-  if (it == clients_.end() || !it->second.in_club) return;
+  if (it == clients_.end() || !it->second.in_club) return false;
+
+  // A seated client may be queued too: either way they must not be seated
+  // again, least of all on the table they free below.
+  scheduler_->Remove(name);
+  EndWait(it->second, time);
 
   if (it->second.table_id) {
-    Table& table = tables_[*it->second.table_id];
-    const auto minutes = time - table.occupied_since;
-    table.busy_minutes += minutes;
-    table.revenue += cfg_.hourly_price * MinutesToHoursRounded(minutes);
-    table.occupant.reset();
+    const std::size_t table_idx = *it->second.table_id;
+    ReleaseTable(table_idx, time);
     it->second.table_id.reset();
 
-    if (!queue_.empty()) {
-      const auto next_name = queue_.front();
-      queue_.pop_front();
-      SeatClient(table.id - 1, next_name, time, EventId::kOutgoingSeated, log);
+    if (auto next_name = scheduler_->Next(table_idx)) {
+      SeatClient(table_idx, *next_name, time, EventId::kOutgoingSeated, log);
     }
   }
 
   if (emit_left_event)
     log.push_back({time, EventId::kOutgoingLeft, name});
   it->second.in_club = false;
+  return true;
 }
 
-void Club::HandleLeft(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
+bool Club::HandleLeft(const IncomingEvent& ev, std::vector<OutgoingEvent>& log) {
   log.push_back({ev.time, ev.id, ev.payload[0]});
-  DropClient(ev.payload[0], ev.time, log, false);
+  return DropClient(ev.payload[0], ev.time, log, false);
 }
 
 }  // namespace cc
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "compact.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "club.hpp"
+
+namespace cc {
+
+std::vector<IncomingEvent> Compact(const Config& cfg,
+                                   const std::vector<IncomingEvent>& events,
+                                   const CompactMode mode) {
+  Club club(cfg);
+  std::vector<OutgoingEvent> log;
+  std::vector<bool> effective(events.size(), false);
+  // Clients whose events may influence tables: they sat down or queued.
+  std::unordered_set<std::string> touched;
+
+  club.Open(log);
+  for (std::size_t i = 0; i < events.size(); ++i) {
+    const auto& ev = events[i];
+    const std::size_t mark = log.size();
+    effective[i] = club.Process(ev, log);
+    if (!effective[i]) continue;
+
+    if (ev.id == EventId::kClientSeated) {
+      touched.insert(ev.payload[0]);
+    } else if (ev.id == EventId::kClientWaiting) {
+      // Queue overflow sends the client away with ID 11 right away.
+      const bool overflow =
+          std::any_of(log.begin() + static_cast<std::ptrdiff_t>(mark), log.end(),
+                      [](const OutgoingEvent& o) { return o.id == EventId::kOutgoingLeft; });
+      if (!overflow) touched.insert(ev.payload[0]);
+    }
+  }
+
+  std::vector<IncomingEvent> out;
+  for (std::size_t i = 0; i < events.size(); ++i) {
+    if (!effective[i]) continue;
+    if (mode == CompactMode::kStats && !touched.contains(events[i].payload[0]))
+      continue;
+    out.push_back(events[i]);
+  }
+  return out;
+}
+
+void WriteInput(const ParsedInput& in, std::ostream& out) {
+  out << in.cfg.table_count << '\n'
+      << in.cfg.open_time.ToString() << ' ' << in.cfg.close_time.ToString() << '\n'
+      << in.cfg.hourly_price << '\n';
+  for (const auto& ev : in.events) {
+    out << ev.time.ToString() << ' ' << static_cast<int>(ev.id);
+    for (const auto& tok : ev.payload) out << ' ' << tok;
+    out << '\n';
+  }
+}
+
+}  // namespace cc
@@ -0,0 +1,103 @@
+#include "follow.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+namespace cc {
+
+namespace {
+
+constexpr std::size_t kChunk = 64 * 1024;
+
+}  // namespace
+
+Follower::Follower(const std::filesystem::path& path) : path_(path.string()) {
+  fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0) throw std::runtime_error("cannot open '" + path_ + '\'');
+#if defined(__linux__)
+  notify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (notify_fd_ >= 0 &&
+      ::inotify_add_watch(notify_fd_, path_.c_str(), IN_MODIFY | IN_CLOSE_WRITE) < 0) {
+    ::close(notify_fd_);
+    notify_fd_ = -1;
+  }
+#endif
+}
+
+Follower::~Follower() {
+  if (notify_fd_ >= 0) ::close(notify_fd_);
+  if (fd_ >= 0) ::close(fd_);
+}
+
+bool Follower::Poll(std::vector<OutgoingEvent>& log) {
+  if (finished_) return false;
+
+  struct stat st {};
+  if (::fstat(fd_, &st) != 0)
+    throw std::runtime_error("cannot stat '" + path_ + "': " + std::strerror(errno));
+  if (static_cast<std::uint64_t>(st.st_size) < offset_)
+    throw std::runtime_error("'" + path_ + "' was truncated while following");
+
+  const std::size_t lines = parser_.line_no();
+  std::string chunk(kChunk, '\0');
+  for (;;) {
+    const ssize_t n = ::pread(fd_, chunk.data(), chunk.size(), static_cast<off_t>(offset_));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("cannot read '" + path_ + "': " + std::strerror(errno));
+    }
+    if (n == 0) break;
+    offset_ += static_cast<std::uint64_t>(n);
+    parser_.Feed({chunk.data(), static_cast<std::size_t>(n)});
+    Drain(log);
+  }
+  return parser_.line_no() != lines;
+}
+
+void Follower::Finish(std::vector<OutgoingEvent>& log) {
+  if (finished_) return;
+  Poll(log);
+  parser_.Finish();
+  Drain(log);  // last line without '\n'; throws if the header is incomplete
+  club_->Close(log);
+  finished_ = true;
+}
+
+void Follower::Drain(std::vector<OutgoingEvent>& log) {
+  IncomingEvent ev;
+  for (;;) {
+    const bool got = parser_.Next(ev);
+    if (!club_ && parser_.config()) {
+      club_.emplace(*parser_.config());
+      club_->Open(log);
+    }
+    if (!got) return;
+    club_->Process(ev, log);
+  }
+}
+
+void Follower::Wait(const std::chrono::milliseconds timeout) {
+  if (notify_fd_ < 0) {
+    std::this_thread::sleep_for(timeout);
+    return;
+  }
+  pollfd pfd{notify_fd_, POLLIN, 0};
+  if (::poll(&pfd, 1, static_cast<int>(timeout.count())) > 0) {
+    // Drain the queued notifications, their content does not matter.
+    char buf[4096];
+    while (::read(notify_fd_, buf, sizeof buf) > 0) {
+    }
+  }
+}
+
+}  // namespace cc
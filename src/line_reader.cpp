@@ -0,0 +1,170 @@
+#include "line_reader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cc {
+
+namespace {
+
+ssize_t ReadBlock(const int fd, std::vector<char>& data) {
+  ssize_t n;
+  do {
+    n = ::read(fd, data.data(), data.size());
+  } while (n < 0 && errno == EINTR);
+  return n;
+}
+
+}  // namespace
+
+LineReader::LineReader(const std::filesystem::path& path,
+                       const std::size_t block_size)
+    : path_(path.string()) {
+  fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0) throw std::runtime_error("cannot open '" + path_ + '\'');
+  struct stat st {};
+  read_ahead_ = ::fstat(fd_, &st) == 0 && S_ISREG(st.st_mode);
+  const std::size_t size = block_size == 0 ? 1 : block_size;
+
+  if (!read_ahead_) {
+    blocks_[0].data.resize(std::min(size, kPipeBlockSize));
+    return;
+  }
+#if defined(POSIX_FADV_SEQUENTIAL)
+  // Kernel hint only, failures are ignored.
+  (void)::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  for (auto& b : blocks_) b.data.resize(size);
+  worker_ = std::thread([this] { Produce(); });
+}
+
+LineReader::~LineReader() {
+  {
+    std::lock_guard lock(mu_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (worker_.joinable()) worker_.join();
+  if (fd_ >= 0) ::close(fd_);
+}
+
+void LineReader::Produce() {
+  std::size_t idx = 0;
+  off_t offset = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(mu_);
+      cv_.wait(lock, [&] { return stop_ || !blocks_[idx].filled; });
+      if (stop_) return;
+    }
+
+    // The block is ours until `filled` is set, no lock needed for the data.
+    Block& b = blocks_[idx];
+    const ssize_t n = ReadBlock(fd_, b.data);
+    const int err = n < 0 ? errno : 0;
+
+    if (n > 0) {
+      offset += static_cast<off_t>(n);
+#if defined(POSIX_FADV_WILLNEED)
+      (void)::posix_fadvise(fd_, offset, static_cast<off_t>(b.data.size()),
+                            POSIX_FADV_WILLNEED);
+#endif
+    }
+
+    {
+      std::lock_guard lock(mu_);
+      b.size = n > 0 ? static_cast<std::size_t>(n) : 0;
+      b.error = err;
+      b.eof = n <= 0;
+      b.filled = true;
+    }
+    cv_.notify_all();
+    if (n <= 0) return;
+    idx ^= 1;
+  }
+}
+
+bool LineReader::ReadInline() {
+  Block& b = blocks_[0];
+  const ssize_t n = ReadBlock(fd_, b.data);
+  if (n < 0) {
+    done_ = true;
+    throw std::runtime_error("cannot read '" + path_ + "': " + std::strerror(errno));
+  }
+  if (n == 0) {
+    done_ = true;
+    have_block_ = false;
+    return false;
+  }
+  b.size = static_cast<std::size_t>(n);
+  have_block_ = true;
+  pos_ = 0;
+  return true;
+}
+
+bool LineReader::Advance() {
+  if (!read_ahead_) return ReadInline();
+
+  std::unique_lock lock(mu_);
+  if (have_block_) {
+    Block& b = blocks_[cur_];
+    const bool last = b.eof;
+    b.filled = false;
+    have_block_ = false;
+    cv_.notify_all();
+    if (last) {
+      done_ = true;
+      return false;
+    }
+    cur_ ^= 1;
+  }
+
+  cv_.wait(lock, [&] { return blocks_[cur_].filled; });
+  const Block& b = blocks_[cur_];
+  if (b.error != 0) {
+    done_ = true;
+    throw std::runtime_error("cannot read '" + path_ + "': " +
+                             std::strerror(b.error));
+  }
+  have_block_ = true;
+  pos_ = 0;
+  return true;
+}
+
+bool LineReader::Next(std::string& line) {
+  line.clear();
+  bool got = false;
+  for (;;) {
+    if (have_block_) {
+      const Block& b = blocks_[cur_];
+      const char* begin = b.data.data() + pos_;
+      const char* end = b.data.data() + b.size;
+      if (begin != end) {
+        got = true;
+        const auto* nl = static_cast<const char*>(
+            std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+        if (nl != nullptr) {
+          line.append(begin, nl);
+          pos_ = static_cast<std::size_t>(nl - b.data.data()) + 1;
+          ++line_no_;
+          return true;
+        }
+        line.append(begin, end);  // line continues in the next block
+        pos_ = b.size;
+      }
+    }
+    if (done_ || !Advance()) {
+      if (!got) return false;
+      ++line_no_;  // last line without trailing '\n'
+      return true;
+    }
+  }
+}
+
+}  // namespace cc
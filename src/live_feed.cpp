@@ -0,0 +1,113 @@
+#include "live_feed.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace cc {
+
+namespace {
+
+constexpr std::size_t kChunk = 64 * 1024;
+
+}  // namespace
+
+LiveFeed::LiveFeed(Runtime& rt, const std::vector<std::filesystem::path>& paths,
+                   SinkFactory sinks)
+    : rt_(rt), sinks_(std::move(sinks)), inputs_(paths.size()) {
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    Input& in = inputs_[i];
+    in.path = paths[i].string();
+    // O_NONBLOCK: opening a FIFO must not wait for its writer.
+    in.fd = ::open(in.path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (in.fd < 0) in.error = "cannot open '" + in.path + '\'';
+  }
+}
+
+LiveFeed::~LiveFeed() {
+  for (auto& in : inputs_) {
+    if (in.fd >= 0) ::close(in.fd);
+  }
+}
+
+void LiveFeed::Run() {
+  std::string chunk(kChunk, '\0');
+  std::vector<pollfd> fds;
+  std::vector<std::size_t> idx;
+  for (;;) {
+    fds.clear();
+    idx.clear();
+    for (std::size_t i = 0; i < inputs_.size(); ++i) {
+      if (inputs_[i].fd < 0) continue;
+      fds.push_back({inputs_[i].fd, POLLIN, 0});
+      idx.push_back(i);
+    }
+    if (fds.empty()) return;
+
+    if (::poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error(std::string("poll failed: ") + std::strerror(errno));
+    }
+    // A FIFO that never had a writer reports nothing, so read() returning
+    // 0 after a reported event really is the end of the input.
+    for (std::size_t k = 0; k < fds.size(); ++k) {
+      if (fds[k].revents == 0) continue;
+      Input& in = inputs_[idx[k]];
+      try {
+        Read(idx[k], chunk);
+      } catch (const std::exception& ex) {
+        in.error = ex.what();
+        End(in);
+      }
+    }
+  }
+}
+
+void LiveFeed::Read(const std::size_t idx, std::string& chunk) {
+  Input& in = inputs_[idx];
+  // One chunk per wake-up keeps a large regular file from starving the rest.
+  ssize_t n;
+  do {
+    n = ::read(in.fd, chunk.data(), chunk.size());
+  } while (n < 0 && errno == EINTR);
+  if (n < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+    throw std::runtime_error("cannot read '" + in.path + "': " + std::strerror(errno));
+  }
+  if (n == 0) {
+    in.parser.Finish();
+    Drain(idx);  // last line without '\n'; throws if the header is incomplete
+    End(in);
+    return;
+  }
+  in.parser.Feed({chunk.data(), static_cast<std::size_t>(n)});
+  Drain(idx);
+}
+
+void LiveFeed::Drain(const std::size_t idx) {
+  Input& in = inputs_[idx];
+  IncomingEvent ev;
+  for (;;) {
+    const bool got = in.parser.Next(ev);
+    if (in.club == nullptr && in.parser.config())
+      in.club = &rt_.Spawn(*in.parser.config(), sinks_ ? sinks_(idx) : EventSink{});
+    if (!got) return;
+    // Throws std::logic_error once the club itself has failed.
+    in.club->Push(std::move(ev));
+  }
+}
+
+void LiveFeed::End(Input& in) {
+  if (in.fd >= 0) {
+    ::close(in.fd);
+    in.fd = -1;
+  }
+  if (in.club != nullptr) in.club->Close();
+}
+
+}  // namespace cc
@@ -1,42 +1,252 @@
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <string_view>
 #include <vector>
 
 #include "club.hpp"
+#include "compact.hpp"
+#include "follow.hpp"
+#include "live_feed.hpp"
+#include "occupancy.hpp"
 #include "parser.hpp"
+#include "runtime.hpp"
+#include "stats_shm.hpp"
+
+static std::string Format(const cc::OutgoingEvent& ev) {
+    if (ev.id == cc::EventId::kError && ev.payload.empty()) return ev.time.ToString();
+    return ev.time.ToString() + ' ' + std::to_string(static_cast<int>(ev.id)) + ' ' +
+           ev.payload;
+}
+
+static std::string Format(const cc::Table& t) {
+    const std::uint32_t h = t.busy_minutes / 60u;
+    const std::uint32_t m = t.busy_minutes % 60u;
+    const auto total = static_cast<std::uint16_t>(h * 60u + m);
+    return std::to_string(t.id) + ' ' + std::to_string(t.revenue) + ' ' +
+           cc::Time(total).ToString();
+}
 
 static void PrintLog(const std::vector<cc::OutgoingEvent>& log) {
-    auto dump = [](const cc::OutgoingEvent& ev) {
-        if (ev.id == cc::EventId::kError && ev.payload.empty()) {
-            std::cout << ev.time.ToString() << '\n';
-            return;
+    for (const auto& ev : log) std::cout << Format(ev) << '\n';
+}
+
+// task compact <input_file> [--keep-events]
+static int RunCompact(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: task compact <input_file> [--keep-events]\n";
+        return 1;
+    }
+    const bool keep_events = argc > 3 && std::string_view(argv[3]) == "--keep-events";
+
+    auto parsed = cc::ParseFile(argv[2]);
+    parsed.events = cc::Compact(parsed.cfg, parsed.events,
+                                keep_events ? cc::CompactMode::kEvents
+                                            : cc::CompactMode::kStats);
+    cc::WriteInput(parsed, std::cout);
+    return 0;
+}
+
+// task query <index_file> <HH:MM> [<HH:MM>]
+static int RunQuery(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Usage: task query <index_file> <HH:MM> [<HH:MM>]\n";
+        return 1;
+    }
+    std::ifstream in(argv[2]);
+    if (!in) throw std::runtime_error(std::string("cannot open '") + argv[2] + '\'');
+    const auto index = cc::OccupancyIndex::Load(in);
+
+    const auto from = cc::Time::Parse(argv[3]);
+    if (argc < 5) {
+        for (const auto& [id, client] : index.BusyAt(from))
+            std::cout << id << ' ' << client << '\n';
+        std::cout << "waiting " << index.WaitingAt(from) << '\n';
+        return 0;
+    }
+    const auto to = cc::Time::Parse(argv[4]);
+    for (const auto id : index.TablesBusyDuring(from, to)) std::cout << id << '\n';
+    std::cout << "max_waiting " << index.MaxWaiting(from, to) << '\n';
+    return 0;
+}
+
+// task live <input_file>...
+// Replays several days (regular files or FIFOs) at once on a coroutine
+// runtime; each output line is prefixed with its input file.
+static int RunLive(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: task live <input_file>...\n";
+        return 1;
+    }
+    cc::Runtime rt;
+    std::mutex out_mu;
+    const std::vector<std::filesystem::path> paths(argv + 2, argv + argc);
+
+    // Inputs are multiplexed on this thread, the clubs share the pool.
+    cc::LiveFeed feed(rt, paths, [&](const std::size_t i) -> cc::EventSink {
+        return [&out_mu, file = paths[i].string()](const cc::OutgoingEvent& ev) {
+            std::lock_guard lock(out_mu);
+            std::cout << file << ": " << Format(ev) << '\n';
+        };
+    });
+    feed.Run();
+    rt.Wait();
+
+    bool failed = false;
+    for (std::size_t i = 0; i < feed.size(); ++i) {
+        const cc::LiveClub* club = feed.club(i);
+        // A club that failed in the runtime also rejects further Push()
+        // calls; its own error is the one worth reporting.
+        std::string error = feed.error(i);
+        if (const auto club_error = club != nullptr ? club->error() : nullptr) {
+            try {
+                std::rethrow_exception(club_error);
+            } catch (const std::exception& ex) {
+                error = ex.what();
+            }
+        }
+        if (!error.empty() || club == nullptr) {
+            failed = true;
+            std::cerr << argv[i + 2] << ": " << error << '\n';
+            continue;
         }
-        std::cout << ev.time.ToString() << ' ' << static_cast<int>(ev.id) << ' '
-                  << ev.payload << '\n';
+        for (const auto& t : club->tables())
+            std::cout << argv[i + 2] << ": " << Format(t) << '\n';
+    }
+    return failed ? 1 : 0;
+}
+
+// task stats <shm_name> [--remove]
+static int RunStats(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: task stats <shm_name> [--remove]\n";
+        return 1;
+    }
+    if (argc > 3 && std::string_view(argv[3]) == "--remove")
+        return cc::StatsPublisher::Remove(argv[2]) ? 0 : 1;
+
+    const auto snap = cc::StatsReader(argv[2]).Read();
+    std::cout << "version " << snap.version << '\n'
+              << "queue " << snap.queue_length << '\n';
+    for (const auto& t : snap.tables) {
+        std::cout << Format(t);
+        if (t.occupant) std::cout << ' ' << *t.occupant << ' ' << t.occupied_since.ToString();
+        std::cout << '\n';
+    }
+    return 0;
+}
+
+static cc::Time LocalNow() {
+    const std::time_t now = std::time(nullptr);
+    std::tm tm{};
+    localtime_r(&now, &tm);
+    return cc::Time{static_cast<std::uint16_t>(tm.tm_hour * 60 + tm.tm_min)};
+}
+
+// task follow <input_file> [--interval <ms>] [--no-clock] [--publish <shm_name>]
+// Prints events as lines are appended. The day is closed once
+// <input_file>.done exists or, unless --no-clock, local time reaches the
+// close time.
+static int RunFollow(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: task follow <input_file> [--interval <ms>] [--no-clock]"
+                     " [--publish <shm_name>]\n";
+        return 1;
+    }
+    const std::string path = argv[2];
+    std::chrono::milliseconds interval{1000};
+    bool use_clock = true;
+    const char* shm_name = nullptr;
+    for (int i = 3; i < argc; ++i) {
+        const std::string_view opt = argv[i];
+        if (opt == "--no-clock") use_clock = false;
+        else if (opt == "--interval" && i + 1 < argc)
+            interval = std::chrono::milliseconds(std::stoul(argv[++i]));
+        else if (opt == "--publish" && i + 1 < argc) shm_name = argv[++i];
+        else throw std::runtime_error("unknown option '" + std::string(opt) + '\'');
+    }
+
+    cc::Follower follower(path);
+    std::optional<cc::StatsPublisher> publisher;
+    std::vector<cc::OutgoingEvent> log;
+    const auto flush = [&] {
+        PrintLog(log);
+        std::cout.flush();
+        log.clear();
+        if (shm_name == nullptr || !follower.config()) return;
+        if (!publisher) publisher.emplace(shm_name, follower.config()->table_count);
+        publisher->Publish(follower.club());
     };
-    for (const auto& ev : log) dump(ev);
+
+    for (;;) {
+        follower.Poll(log);
+        flush();
+        const auto& cfg = follower.config();
+        if (std::filesystem::exists(path + ".done")) break;
+        if (use_clock && cfg && !(LocalNow() < cfg->close_time)) break;
+        follower.Wait(interval);
+    }
+    follower.Finish(log);  // picks up anything appended meanwhile
+    flush();
+
+    for (const auto& t : follower.club().tables()) std::cout << Format(t) << '\n';
+    return 0;
 }
 
 int main(int argc, char** argv) {
     try {
         if (argc < 2) {
-            std::cerr << "Usage: computer_club <input_file>\n";
+            std::cerr << "Usage: task <input_file> [--save-index <index_file>] [--publish <shm_name>]\n"
+                         "       task compact <input_file> [--keep-events]\n"
+                         "       task query <index_file> <HH:MM> [<HH:MM>]\n"
+                         "       task live <input_file>...\n"
+                         "       task stats <shm_name> [--remove]\n"
+                         "       task follow <input_file> [--interval <ms>] [--no-clock]"
+                         " [--publish <shm_name>]\n";
             return 1;
         }
+        if (std::string_view(argv[1]) == "compact") return RunCompact(argc, argv);
+        if (std::string_view(argv[1]) == "query") return RunQuery(argc, argv);
+        if (std::string_view(argv[1]) == "live") return RunLive(argc, argv);
+        if (std::string_view(argv[1]) == "stats") return RunStats(argc, argv);
+        if (std::string_view(argv[1]) == "follow") return RunFollow(argc, argv);
+
+        const char* index_path = nullptr;
+        const char* shm_name = nullptr;
+        for (int i = 2; i < argc; ++i) {
+            const std::string_view opt = argv[i];
+            if (opt == "--save-index" && i + 1 < argc) index_path = argv[++i];
+            else if (opt == "--publish" && i + 1 < argc) shm_name = argv[++i];
+            else throw std::runtime_error("unknown option '" + std::string(opt) + '\'');
+        }
 
         const auto parsed = cc::ParseFile(argv[1]);
         cc::Club club(parsed.cfg);
 
+        // Publishes the tables each event changed.
+        std::optional<cc::StatsPublisher> publisher;
+        if (shm_name != nullptr) {
+            publisher.emplace(shm_name, parsed.cfg.table_count);
+            club.SetChangeHook([&publisher](const cc::Club& c, const auto changed) {
+                publisher->Publish(c, changed);
+            });
+        }
+
         std::vector<cc::OutgoingEvent> log;
         club.Run(parsed.events, log);
 
         PrintLog(log);
 
-        for (const auto& t : club.tables()) {
-            const std::uint32_t h = t.busy_minutes / 60u;
-            const std::uint32_t m = t.busy_minutes % 60u;
-            const auto total = static_cast<std::uint16_t>(h * 60u + m);
-            std::cout << t.id << ' ' << t.revenue << ' ' << cc::Time(total).ToString()
-                      << '\n';
+        for (const auto& t : club.tables()) std::cout << Format(t) << '\n';
+
+        if (index_path != nullptr) {
+            std::ofstream out(index_path);
+            if (!out) throw std::runtime_error(std::string("cannot open '") + index_path + '\'');
+            cc::OccupancyIndex(club).Save(out);
         }
     } catch (const std::exception& ex) {
         std::cerr << ex.what() << '\n';
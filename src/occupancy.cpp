@@ -0,0 +1,170 @@
+#include "occupancy.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "club.hpp"
+
+namespace cc {
+
+namespace {
+
+constexpr std::string_view kMagic = "occupancy";
+constexpr int kVersion = 1;
+
+std::uint16_t Clamp(const Time t) {
+  return std::min(t.minutes(), static_cast<std::uint16_t>(OccupancyIndex::kMinutes));
+}
+
+Time ReadTime(std::istream& in) {
+  std::string s;
+  if (!(in >> s)) throw std::runtime_error("occupancy index: truncated");
+  try {
+    return Time::Parse(s);
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error("occupancy index: bad time '" + s + '\'');
+  }
+}
+
+}  // namespace
+
+OccupancyIndex::OccupancyIndex(const std::size_t table_count,
+                               std::vector<Session> sessions,
+                               std::vector<WaitInterval> waits)
+    : table_count_(table_count),
+      words_((table_count + 63) / 64),
+      busy_(kMinutes * words_, 0),
+      by_table_(table_count),
+      waiting_(kMinutes + 1, 0),
+      waits_(std::move(waits)) {
+  for (auto& s : sessions) {
+    if (s.table_id == 0 || s.table_id > table_count_)
+      throw std::runtime_error("occupancy index: bad table id");
+    const std::size_t bit = s.table_id - 1;
+    for (std::uint16_t m = Clamp(s.from); m < Clamp(s.to); ++m)
+      busy_[m * words_ + bit / 64] |= std::uint64_t{1} << (bit % 64);
+    by_table_[bit].push_back(std::move(s));
+  }
+  for (auto& v : by_table_)
+    std::ranges::sort(v, {}, [](const Session& s) { return s.from.minutes(); });
+
+  // Difference array, then prefix sums.
+  for (const auto& w : waits_) {
+    ++waiting_[Clamp(w.from)];
+    --waiting_[Clamp(w.to)];
+  }
+  for (std::size_t m = 1; m <= kMinutes; ++m) waiting_[m] += waiting_[m - 1];
+}
+
+OccupancyIndex::OccupancyIndex(const Club& club)
+    : OccupancyIndex(club.table_count(), club.sessions(), club.waits()) {}
+
+bool OccupancyIndex::IsBusy(const std::size_t table_id, const Time t) const {
+  if (table_id == 0 || table_id > table_count_ || t.minutes() >= kMinutes) return false;
+  const std::size_t bit = table_id - 1;
+  return (Row(t)[bit / 64] >> (bit % 64)) & 1u;
+}
+
+std::optional<std::string> OccupancyIndex::OccupantAt(const std::size_t table_id,
+                                                      const Time t) const {
+  if (!IsBusy(table_id, t)) return std::nullopt;
+  const auto& v = by_table_[table_id - 1];
+  // Last session starting at or before t; sessions at a table never overlap.
+  auto it = std::ranges::upper_bound(v, t.minutes(), {},
+                                     [](const Session& s) { return s.from.minutes(); });
+  while (it != v.begin()) {
+    --it;
+    if (t < it->to) return it->client;
+  }
+  return std::nullopt;
+}
+
+std::size_t OccupancyIndex::BusyCount(const Time t) const {
+  if (t.minutes() >= kMinutes) return 0;
+  std::size_t n = 0;
+  const auto* row = Row(t);
+  for (std::size_t w = 0; w < words_; ++w) n += std::popcount(row[w]);
+  return n;
+}
+
+std::vector<std::pair<std::size_t, std::string>> OccupancyIndex::BusyAt(const Time t) const {
+  std::vector<std::pair<std::size_t, std::string>> out;
+  if (t.minutes() >= kMinutes) return out;
+  const auto* row = Row(t);
+  for (std::size_t w = 0; w < words_; ++w) {
+    for (std::uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+      const std::size_t table_id = w * 64 + std::countr_zero(bits) + 1;
+      out.emplace_back(table_id, *OccupantAt(table_id, t));
+    }
+  }
+  return out;
+}
+
+std::size_t OccupancyIndex::WaitingAt(const Time t) const {
+  return t.minutes() >= kMinutes ? 0 : waiting_[t.minutes()];
+}
+
+std::vector<std::size_t> OccupancyIndex::TablesBusyDuring(const Time from,
+                                                          const Time to) const {
+  std::vector<std::uint64_t> acc(words_, 0);
+  for (std::uint16_t m = Clamp(from); m < Clamp(to); ++m) {
+    const auto* row = busy_.data() + std::size_t{m} * words_;
+    for (std::size_t w = 0; w < words_; ++w) acc[w] |= row[w];
+  }
+  std::vector<std::size_t> out;
+  for (std::size_t w = 0; w < words_; ++w) {
+    for (std::uint64_t bits = acc[w]; bits != 0; bits &= bits - 1)
+      out.push_back(w * 64 + std::countr_zero(bits) + 1);
+  }
+  return out;
+}
+
+std::size_t OccupancyIndex::MaxWaiting(const Time from, const Time to) const {
+  std::uint32_t best = 0;
+  for (std::uint16_t m = Clamp(from); m < Clamp(to); ++m) best = std::max(best, waiting_[m]);
+  return best;
+}
+
+void OccupancyIndex::Save(std::ostream& out) const {
+  std::size_t session_count = 0;
+  for (const auto& v : by_table_) session_count += v.size();
+
+  out << kMagic << ' ' << kVersion << '\n' << table_count_ << '\n' << session_count << '\n';
+  for (const auto& v : by_table_) {
+    for (const auto& s : v) {
+      out << s.table_id << ' ' << s.from.ToString() << ' ' << s.to.ToString() << ' '
+          << s.client << '\n';
+    }
+  }
+  out << waits_.size() << '\n';
+  for (const auto& w : waits_)
+    out << w.from.ToString() << ' ' << w.to.ToString() << ' ' << w.client << '\n';
+}
+
+OccupancyIndex OccupancyIndex::Load(std::istream& in) {
+  std::string magic;
+  int version = 0;
+  std::size_t table_count = 0, n = 0;
+  if (!(in >> magic >> version) || magic != kMagic || version != kVersion)
+    throw std::runtime_error("occupancy index: bad header");
+  if (!(in >> table_count >> n)) throw std::runtime_error("occupancy index: truncated");
+
+  std::vector<Session> sessions(n);
+  for (auto& s : sessions) {
+    if (!(in >> s.table_id)) throw std::runtime_error("occupancy index: truncated");
+    s.from = ReadTime(in);
+    s.to = ReadTime(in);
+    if (!(in >> s.client)) throw std::runtime_error("occupancy index: truncated");
+  }
+  if (!(in >> n)) throw std::runtime_error("occupancy index: truncated");
+  std::vector<WaitInterval> waits(n);
+  for (auto& w : waits) {
+    w.from = ReadTime(in);
+    w.to = ReadTime(in);
+    if (!(in >> w.client)) throw std::runtime_error("occupancy index: truncated");
+  }
+  return {table_count, std::move(sessions), std::move(waits)};
+}
+
+}  // namespace cc
@@ -2,10 +2,11 @@
 
 #include <charconv>
 #include <cctype>
-#include <fstream>
 #include <regex>
 #include <sstream>
 
+#include "line_reader.hpp"
+
 namespace {
 
 [[noreturn]] void Fail(std::size_t line, const std::string& msg) {
@@ -34,115 +35,159 @@ bool IsDigits(std::string_view s) {
     return !s.empty() && std::all_of(s.begin(), s.end(), ::isdigit);
 }
 
-/// Read next non‑empty line, preserving original numbering.
-std::string ReadNonEmpty(std::ifstream& in, std::string& buf, std::size_t& line) {
-    while (std::getline(in, buf)) {
-        ++line;
-        if (!buf.empty()) return buf;
-    }
-    Fail(line + 1, "unexpected EOF");   // never returns
-}
-
 }  // namespace
 
 namespace cc {
 
-ParsedInput ParseFile(const std::filesystem::path& path) {
-    std::ifstream in(path);
-    if (!in) throw std::runtime_error("cannot open '" + path.string() + '\'');
+namespace {
 
-    ParsedInput out;
-    std::string line;
-    std::size_t line_no = 0;
+constexpr std::size_t kHeaderLines = 3;
 
+// `field` is 0 (table count), 1 (open/close) or 2 (hourly price).
+void ParseHeaderLine(const std::string& line, std::size_t field,
+                     std::size_t line_no, Config& cfg) {
+    std::istringstream ss(line);
+    switch (field) {
     // ---------- 1. table count -------------------------------------------------
-    {
-        std::string s = ReadNonEmpty(in, line, line_no);
-        std::istringstream ss(s);
+    case 0: {
         std::string tok, extra;
         if (!(ss >> tok) || ss >> extra)
             Fail(line_no, "expected single integer table count");
-        out.cfg.table_count = ToUInt<std::size_t>(tok, "table count", line_no);
+        cfg.table_count = ToUInt<std::size_t>(tok, "table count", line_no);
+        break;
     }
 
     // ---------- 2. open / close times -----------------------------------------
-    {
-        std::istringstream ss(ReadNonEmpty(in, line, line_no));
+    case 1: {
         std::string open_s, close_s, extra;
         if (!(ss >> open_s >> close_s) || (ss >> extra))
             Fail(line_no, "expected two times: <open> <close>");
 
-        out.cfg.open_time  = Time::Parse(open_s);
-        out.cfg.close_time = Time::Parse(close_s);
-        if (!(out.cfg.open_time < out.cfg.close_time))
+        cfg.open_time  = Time::Parse(open_s);
+        cfg.close_time = Time::Parse(close_s);
+        if (!(cfg.open_time < cfg.close_time))
             Fail(line_no, "open time must be earlier than close time");
+        break;
     }
 
     // ---------- 3. hourly price -----------------------------------------------
-    {
-        std::string s = ReadNonEmpty(in, line, line_no);
-        std::istringstream ss(s);
+    case 2: {
         std::string price_s, extra;
         if (!(ss >> price_s) || (ss >> extra))
             Fail(line_no, "expected single integer hourly price");
-        out.cfg.hourly_price =
+        cfg.hourly_price =
             ToUInt<std::uint32_t>(price_s, "hourly price", line_no);
+        break;
+    }
+
+    default:
+        throw std::logic_error("ParseHeaderLine: bad field index");
     }
+}
+
+// `last_time` enforces chronological order and is updated.
+IncomingEvent ParseEventLine(const std::string& line, std::size_t line_no,
+                             const Config& cfg, Time& last_time) {
+    std::istringstream ss(line);
+
+    std::string time_tok;
+    std::string id_tok;
+    std::string first_payload;
 
-    // ----------- 4. events --------------------------------------------------
-    Time last_time{0};
+    //  Обязательный минимум: три токена
+    if (!(ss >> time_tok >> id_tok >> first_payload))
+        Fail(line_no, "event must be: <time> <id> <payload>");
 
-    while (std::getline(in, line)) {
-        ++line_no;
-        if (line.empty()) continue;
+    if (!IsDigits(id_tok))
+        Fail(line_no, "event id must be positive integer");
 
-        std::istringstream ss(line);
+    int id_int = ToUInt<int>(id_tok, "event id", line_no);
 
-        std::string time_tok;
-        std::string id_tok;
-        std::string first_payload;
+    if (id_int < 1 || id_int > 4)
+        Fail(line_no, "event id must be 1, 2, 3 or 4 (incoming events only)");
 
-        //  Обязательный минимум: три токена
-        if (!(ss >> time_tok >> id_tok >> first_payload))
-            Fail(line_no, "event must be: <time> <id> <payload>");
+    if (!NameOk(first_payload))
+        Fail(line_no, "invalid client name: " + first_payload);
 
-        if (!IsDigits(id_tok))
-            Fail(line_no, "event id must be positive integer");
+    IncomingEvent ev;
+    ev.time = Time::Parse(time_tok);
+    ev.id   = static_cast<EventId>(id_int);
+    ev.payload.push_back(std::move(first_payload));
 
-        int id_int = ToUInt<int>(id_tok, "event id", line_no);
+    /*  Остальные токены → payload          */
+    std::string tok;
+    while (ss >> tok) ev.payload.push_back(tok);
 
-        if (id_int < 1 || id_int > 4)
-            Fail(line_no, "event id must be 1, 2, 3 or 4 (incoming events only)");
+    if (ev.time < last_time)
+        Fail(line_no, "events out of chronological order");
+    last_time = ev.time;
 
-        if (!NameOk(first_payload))
-            Fail(line_no, "invalid client name: " + first_payload);
+    /*  Если второй payload – цифры, считаем это номером стола  */
+    if (ev.payload.size() >= 2 && IsDigits(ev.payload[1])) {
+        auto table =
+            ToUInt<std::size_t>(ev.payload[1], "table id", line_no);
+        if (table == 0 || table > cfg.table_count)
+            Fail(line_no, "table id out of range (1.." +
+                           std::to_string(cfg.table_count) + ')');
+    }
 
-        IncomingEvent ev;
-        ev.time = Time::Parse(time_tok);
-        ev.id   = static_cast<EventId>(id_int);
-        ev.payload.push_back(std::move(first_payload));
+    return ev;
+}
 
-        /*  Остальные токены → payload          */
-        std::string tok;
-        while (ss >> tok) ev.payload.push_back(tok);
+}  // namespace
 
-        if (ev.time < last_time)
-            Fail(line_no, "events out of chronological order");
-        last_time = ev.time;
+void StreamParser::Feed(const std::string_view bytes) {
+    if (pos_ > 0) {
+        buf_.erase(0, pos_);
+        pos_ = 0;
+    }
+    buf_.append(bytes);
+}
 
-        /*  Если второй payload – цифры, считаем это номером стола  */
-        if (ev.payload.size() >= 2 && IsDigits(ev.payload[1])) {
-            auto table =
-                ToUInt<std::size_t>(ev.payload[1], "table id", line_no);
-            if (table == 0 || table > out.cfg.table_count)
-                Fail(line_no, "table id out of range (1.." +
-                               std::to_string(out.cfg.table_count) + ')');
+void StreamParser::Finish() { finished_ = true; }
+
+bool StreamParser::Next(IncomingEvent& ev) {
+    for (;;) {
+        const std::size_t nl = buf_.find('\n', pos_);
+        if (nl != std::string::npos) {
+            line_.assign(buf_, pos_, nl - pos_);
+            pos_ = nl + 1;
+        } else if (finished_ && pos_ < buf_.size()) {  // last line without '\n'
+            line_.assign(buf_, pos_);
+            pos_ = buf_.size();
+        } else {
+            if (finished_ && !cfg_) Fail(line_no_ + 1, "unexpected EOF");
+            return false;
         }
+        if (ParseLine(line_, ev)) return true;
+    }
+}
+
+bool StreamParser::ParseLine(const std::string& line, IncomingEvent& ev) {
+    ++line_no_;
+    if (line.empty()) return false;
 
-        out.events.push_back(std::move(ev));
+    if (header_lines_ < kHeaderLines) {
+        ParseHeaderLine(line, header_lines_++, line_no_, header_);
+        if (header_lines_ == kHeaderLines) cfg_ = header_;
+        return false;
     }
+    ev = ParseEventLine(line, line_no_, *cfg_, last_time_);
+    return true;
+}
 
+ParsedInput ParseFile(const std::filesystem::path& path) {
+    LineReader in(path);  // throws std::runtime_error if cannot open
+    StreamParser parser;
 
+    ParsedInput out;
+    IncomingEvent ev;
+    for (std::string line; in.Next(line);) {
+        if (parser.ParseLine(line, ev)) out.events.push_back(std::move(ev));
+    }
+    parser.Finish();
+    parser.Next(ev);  // only reports a missing header by now
+    out.cfg = *parser.config();
     return out;
 }
 
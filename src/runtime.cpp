@@ -0,0 +1,198 @@
+#include "runtime.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace cc {
+
+namespace {
+
+// Events a busy club processes back to back before yielding its thread.
+constexpr std::size_t kBatch = 64;
+
+}  // namespace
+
+// Fire-and-forget coroutine: starts suspended, frees its frame on return.
+struct Runtime::Task {
+  struct promise_type {
+    Task get_return_object() {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+// Re-queues the coroutine behind the other ready clubs.
+struct Runtime::Yield {
+  Runtime& rt;
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(const std::coroutine_handle<> h) { rt.Schedule(h); }
+  void await_resume() const noexcept {}
+};
+
+// ---------- LiveClub ---------------------------------------------------------
+
+LiveClub::LiveClub(Runtime& rt, const Config& cfg, EventSink sink,
+                   std::unique_ptr<Scheduler> scheduler)
+    : rt_(rt),
+      club_(std::make_unique<Club>(cfg, std::move(scheduler))),
+      sink_(std::move(sink)) {}
+
+void LiveClub::Push(IncomingEvent ev) {
+  std::coroutine_handle<> h;
+  {
+    std::lock_guard lock(mu_);
+    if (closed_) throw std::logic_error("LiveClub: club is closed");
+    pending_.push_back(std::move(ev));
+    h = std::exchange(waiter_, {});
+  }
+  if (h) rt_.Schedule(h);
+}
+
+void LiveClub::Close() {
+  std::coroutine_handle<> h;
+  {
+    std::lock_guard lock(mu_);
+    if (closed_) return;
+    closed_ = true;
+    h = std::exchange(waiter_, {});
+  }
+  if (h) rt_.Schedule(h);
+}
+
+bool LiveClub::NextEvent::await_ready() {
+  std::lock_guard lock(club.mu_);
+  return !club.pending_.empty() || club.closed_;
+}
+
+bool LiveClub::NextEvent::await_suspend(const std::coroutine_handle<> h) {
+  std::lock_guard lock(club.mu_);
+  if (!club.pending_.empty() || club.closed_) return false;  // raced with Push
+  club.waiter_ = h;
+  return true;
+}
+
+std::optional<IncomingEvent> LiveClub::NextEvent::await_resume() {
+  std::lock_guard lock(club.mu_);
+  if (club.pending_.empty()) return std::nullopt;  // closed and drained
+  IncomingEvent ev = std::move(club.pending_.front());
+  club.pending_.pop_front();
+  return ev;
+}
+
+// ---------- Runtime ----------------------------------------------------------
+
+Runtime::Runtime(std::size_t threads) {
+  if (threads == 0) threads = 1;
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) workers_.emplace_back([this] { Work(); });
+}
+
+Runtime::~Runtime() {
+  std::vector<LiveClub*> clubs;
+  {
+    std::lock_guard lock(mu_);
+    for (const auto& c : clubs_) clubs.push_back(c.get());
+  }
+  for (auto* c : clubs) c->Close();
+  Wait();
+
+  {
+    std::lock_guard lock(mu_);
+    stop_ = true;
+  }
+  ready_cv_.notify_all();
+  for (auto& t : workers_) t.join();
+}
+
+LiveClub& Runtime::Spawn(const Config& cfg, EventSink sink,
+                         std::unique_ptr<Scheduler> scheduler) {
+  std::unique_ptr<LiveClub> club(
+      new LiveClub(*this, cfg, std::move(sink), std::move(scheduler)));
+  LiveClub& ref = *club;
+  {
+    std::lock_guard lock(mu_);
+    clubs_.push_back(std::move(club));
+    ++active_;
+  }
+  Schedule(Drive(ref).handle);
+  return ref;
+}
+
+void Runtime::Wait() {
+  std::unique_lock lock(mu_);
+  idle_cv_.wait(lock, [&] { return active_ == 0; });
+}
+
+Runtime::Task Runtime::Drive(LiveClub& lc) {
+  std::vector<OutgoingEvent> log;
+  const auto flush = [&] {
+    if (lc.sink_) {
+      for (const auto& ev : log) lc.sink_(ev);
+    }
+    log.clear();
+  };
+
+  try {
+    lc.club_->Open(log);
+    flush();
+    std::size_t streak = 0;
+    while (auto ev = co_await lc.Next()) {
+      lc.club_->Process(*ev, log);
+      flush();
+      if (++streak == kBatch) {
+        streak = 0;
+        co_await Yield{lc.rt_};
+      }
+    }
+    lc.club_->Close(log);
+    flush();
+    lc.tables_ = lc.club_->tables();
+  } catch (...) {
+    lc.error_ = std::current_exception();
+    std::lock_guard lock(lc.mu_);
+    lc.closed_ = true;  // further Push() calls fail fast
+    lc.pending_.clear();
+  }
+
+  // Free the simulation state right away, only the stats outlive the day.
+  lc.club_.reset();
+  lc.rt_.Finished();
+}
+
+void Runtime::Schedule(const std::coroutine_handle<> h) {
+  {
+    std::lock_guard lock(mu_);
+    ready_.push_back(h);
+  }
+  ready_cv_.notify_one();
+}
+
+void Runtime::Finished() {
+  {
+    std::lock_guard lock(mu_);
+    --active_;
+  }
+  idle_cv_.notify_all();
+}
+
+void Runtime::Work() {
+  for (;;) {
+    std::coroutine_handle<> h;
+    {
+      std::unique_lock lock(mu_);
+      ready_cv_.wait(lock, [&] { return stop_ || !ready_.empty(); });
+      if (ready_.empty()) return;
+      h = ready_.front();
+      ready_.pop_front();
+    }
+    h.resume();
+  }
+}
+
+}  // namespace cc
@@ -0,0 +1,152 @@
+#include "scheduler.hpp"
+
+#include <algorithm>
+
+namespace cc {
+
+// ---------- FifoScheduler ----------------------------------------------------
+
+bool FifoScheduler::Enqueue(const std::string& name) {
+  if (queue_.size() >= capacity_) return false;
+  index_.emplace(name, queue_.insert(queue_.end(), name));
+  return true;
+}
+
+void FifoScheduler::Remove(const std::string& name) {
+  const auto [first, last] = index_.equal_range(name);
+  for (auto it = first; it != last; ++it) queue_.erase(it->second);
+  index_.erase(first, last);
+}
+
+std::optional<std::string> FifoScheduler::Next(std::size_t /*table_idx*/) {
+  if (queue_.empty()) return std::nullopt;
+  const auto [first, last] = index_.equal_range(queue_.front());
+  for (auto it = first; it != last; ++it) {
+    if (it->second == queue_.begin()) {
+      index_.erase(it);
+      break;
+    }
+  }
+  std::string name = std::move(queue_.front());
+  queue_.pop_front();
+  return name;
+}
+
+// ---------- PriorityScheduler ------------------------------------------------
+
+bool PriorityScheduler::Before(const std::size_t a, const std::size_t b) const {
+  const Entry& x = heap_[a];
+  const Entry& y = heap_[b];
+  if (x.tier != y.tier) return x.tier > y.tier;
+  return x.seq < y.seq;
+}
+
+void PriorityScheduler::Swap(const std::size_t a, const std::size_t b) {
+  std::swap(heap_[a], heap_[b]);
+  pos_[heap_[a].name] = a;
+  pos_[heap_[b].name] = b;
+}
+
+void PriorityScheduler::SiftUp(std::size_t i) {
+  while (i > 0) {
+    const std::size_t parent = (i - 1) / 2;
+    if (!Before(i, parent)) break;
+    Swap(i, parent);
+    i = parent;
+  }
+}
+
+void PriorityScheduler::SiftDown(std::size_t i) {
+  for (;;) {
+    const std::size_t l = 2 * i + 1;
+    const std::size_t r = l + 1;
+    std::size_t best = i;
+    if (l < heap_.size() && Before(l, best)) best = l;
+    if (r < heap_.size() && Before(r, best)) best = r;
+    if (best == i) return;
+    Swap(i, best);
+    i = best;
+  }
+}
+
+bool PriorityScheduler::Enqueue(const std::string& name) {
+  if (pos_.contains(name)) return true;
+  if (heap_.size() >= capacity_) return false;
+  const auto tier = tiers_.find(name);
+  heap_.push_back({name, tier == tiers_.end() ? 0u : tier->second, next_seq_++});
+  pos_[name] = heap_.size() - 1;
+  SiftUp(heap_.size() - 1);
+  return true;
+}
+
+void PriorityScheduler::Remove(const std::string& name) {
+  const auto it = pos_.find(name);
+  if (it == pos_.end()) return;
+  const std::size_t i = it->second;
+  const std::size_t last = heap_.size() - 1;
+  if (i != last) Swap(i, last);
+  pos_.erase(name);
+  heap_.pop_back();
+  if (i < heap_.size()) {
+    SiftUp(i);
+    SiftDown(i);
+  }
+}
+
+std::optional<std::string> PriorityScheduler::Next(std::size_t /*table_idx*/) {
+  if (heap_.empty()) return std::nullopt;
+  std::string name = heap_.front().name;
+  Remove(name);
+  return name;
+}
+
+// ---------- ZoneScheduler ----------------------------------------------------
+
+ZoneScheduler::ZoneScheduler(const std::size_t capacity,
+                             std::vector<std::size_t> table_zone,
+                             std::unordered_map<std::string, std::size_t> client_zone)
+    : capacity_(capacity),
+      table_zone_(std::move(table_zone)),
+      client_zone_(std::move(client_zone)) {
+  const std::size_t zones =
+      table_zone_.empty() ? 0 : *std::ranges::max_element(table_zone_) + 1;
+  queues_.resize(zones + 1);
+}
+
+bool ZoneScheduler::Enqueue(const std::string& name) {
+  if (index_.contains(name)) return true;
+  if (index_.size() >= capacity_) return false;
+
+  const std::size_t any = queues_.size() - 1;
+  const auto pref = client_zone_.find(name);
+  const std::size_t zone =
+      pref == client_zone_.end() || pref->second >= any ? any : pref->second;
+  auto& q = queues_[zone];
+  index_.emplace(name, std::pair{zone, q.insert(q.end(), Waiting{name, next_seq_++})});
+  return true;
+}
+
+void ZoneScheduler::Remove(const std::string& name) {
+  const auto it = index_.find(name);
+  if (it == index_.end()) return;
+  queues_[it->second.first].erase(it->second.second);
+  index_.erase(it);
+}
+
+std::optional<std::string> ZoneScheduler::Next(const std::size_t table_idx) {
+  const std::size_t any = queues_.size() - 1;
+  Queue* pick = queues_[any].empty() ? nullptr : &queues_[any];
+  if (table_idx < table_zone_.size()) {
+    Queue& zone = queues_[table_zone_[table_idx]];
+    if (!zone.empty() && (pick == nullptr || zone.front().seq < pick->front().seq))
+      pick = &zone;
+  }
+  if (pick == nullptr) return std::nullopt;
+
+  std::string name = std::move(pick->front().name);
+  pick->pop_front();
+  index_.erase(name);
+  return name;
+}
+
+}  // namespace cc
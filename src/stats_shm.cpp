@@ -0,0 +1,249 @@
+#include "stats_shm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "club.hpp"
+
+namespace cc {
+
+namespace {
+
+// Segment layout, all in 64-bit words:
+//   header  [magic, layout, seq, table_count, queue_length, pad...]
+//   records [flags, since, revenue, busy_minutes, name...] per table
+constexpr std::uint64_t kMagic = 0x434c554253544154;  // "CLUBSTAT"
+constexpr std::uint64_t kLayout = 1;
+
+constexpr std::size_t kMagicWord = 0;
+constexpr std::size_t kLayoutWord = 1;
+constexpr std::size_t kSeqWord = 2;
+constexpr std::size_t kCountWord = 3;
+constexpr std::size_t kQueueWord = 4;
+constexpr std::size_t kHeaderWords = 8;  // one cache line
+
+constexpr std::size_t kFlagsField = 0;
+constexpr std::size_t kSinceField = 1;
+constexpr std::size_t kRevenueField = 2;
+constexpr std::size_t kBusyField = 3;
+constexpr std::size_t kNameField = 4;
+constexpr std::size_t kNameWords = StatsPublisher::kMaxName / sizeof(std::uint64_t);
+constexpr std::size_t kRecordWords = kNameField + kNameWords;
+
+constexpr std::uint64_t kBusyFlag = 1;
+
+static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free,
+              "seqlock needs lock-free 64-bit atomics");
+
+std::atomic_ref<std::uint64_t> Word(std::uint64_t* base, const std::size_t i) {
+  return std::atomic_ref<std::uint64_t>(base[i]);
+}
+
+std::size_t SegmentBytes(const std::size_t table_count) {
+  return (kHeaderWords + table_count * kRecordWords) * sizeof(std::uint64_t);
+}
+
+std::string ShmName(const std::string& name) {
+  return name.starts_with('/') ? name : '/' + name;
+}
+
+[[noreturn]] void Throw(const std::string& what, const std::string& name) {
+  throw std::runtime_error(what + " '" + name + "': " + std::strerror(errno));
+}
+
+}  // namespace
+
+// ---------- StatsPublisher ---------------------------------------------------
+
+StatsPublisher::StatsPublisher(const std::string& name, const std::size_t table_count)
+    : bytes_(SegmentBytes(table_count)), table_count_(table_count) {
+  const std::string path = ShmName(name);
+  // Readers still mapping an old segment keep it until they reopen.
+  ::shm_unlink(path.c_str());
+  const int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) Throw("cannot create shared memory", path);
+  if (::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) {
+    ::close(fd);
+    ::shm_unlink(path.c_str());
+    Throw("cannot size shared memory", path);
+  }
+  void* p = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    ::shm_unlink(path.c_str());
+    Throw("cannot map shared memory", path);
+  }
+  base_ = static_cast<std::uint64_t*>(p);
+
+  // ftruncate() zero-fills: every table starts free. Magic goes last so a
+  // reader never sees a half-initialised header.
+  Word(base_, kLayoutWord).store(kLayout, std::memory_order_relaxed);
+  Word(base_, kCountWord).store(table_count_, std::memory_order_relaxed);
+  Word(base_, kMagicWord).store(kMagic, std::memory_order_release);
+}
+
+StatsPublisher::~StatsPublisher() {
+  if (base_ != nullptr) ::munmap(base_, bytes_);
+}
+
+bool StatsPublisher::Remove(const std::string& name) {
+  return ::shm_unlink(ShmName(name).c_str()) == 0;
+}
+
+void StatsPublisher::Begin() {
+  auto seq = Word(base_, kSeqWord);
+  seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+void StatsPublisher::End() {
+  auto seq = Word(base_, kSeqWord);
+  seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void StatsPublisher::WriteTable(const std::size_t idx, const bool busy,
+                                const std::string* occupant, const Time since,
+                                const std::uint32_t revenue,
+                                const std::uint32_t busy_minutes) {
+  std::uint64_t* rec = base_ + kHeaderWords + idx * kRecordWords;
+  std::uint64_t name[kNameWords] = {};
+  if (busy && occupant != nullptr)
+    std::memcpy(name, occupant->data(), std::min(occupant->size(), kMaxName));
+
+  const auto store = [rec](const std::size_t field, const std::uint64_t v) {
+    Word(rec, field).store(v, std::memory_order_relaxed);
+  };
+  store(kFlagsField, busy ? kBusyFlag : 0);
+  store(kSinceField, busy ? since.minutes() : 0);
+  store(kRevenueField, revenue);
+  store(kBusyField, busy_minutes);
+  for (std::size_t w = 0; w < kNameWords; ++w) store(kNameField + w, name[w]);
+}
+
+void StatsPublisher::WriteTable(const Club& club, const std::size_t idx) {
+  const TableStore& store = club.store();
+  const bool busy = store.IsBusy(idx);
+  WriteTable(idx, busy, busy ? &club.client_name(store.occupant(idx)) : nullptr,
+             store.since(idx), store.revenue(idx), store.busy_minutes(idx));
+}
+
+void StatsPublisher::Publish(const Club& club) {
+  if (club.table_count() != table_count_)
+    throw std::invalid_argument("StatsPublisher: table count mismatch");
+
+  Begin();
+  for (std::size_t i = 0; i < table_count_; ++i) WriteTable(club, i);
+  Word(base_, kQueueWord).store(club.queue_size(), std::memory_order_relaxed);
+  End();
+}
+
+void StatsPublisher::Publish(const Club& club, const std::span<const std::size_t> changed) {
+  if (club.table_count() != table_count_)
+    throw std::invalid_argument("StatsPublisher: table count mismatch");
+
+  Begin();
+  for (const std::size_t i : changed) WriteTable(club, i);
+  Word(base_, kQueueWord).store(club.queue_size(), std::memory_order_relaxed);
+  End();
+}
+
+void StatsPublisher::Publish(const std::vector<Table>& tables,
+                             const std::size_t queue_length) {
+  if (tables.size() != table_count_)
+    throw std::invalid_argument("StatsPublisher: table count mismatch");
+
+  Begin();
+  for (std::size_t i = 0; i < table_count_; ++i) {
+    const Table& t = tables[i];
+    WriteTable(i, t.IsBusy(), t.occupant ? &*t.occupant : nullptr, t.occupied_since,
+               t.revenue, t.busy_minutes);
+  }
+  Word(base_, kQueueWord).store(queue_length, std::memory_order_relaxed);
+  End();
+}
+
+// ---------- StatsReader ------------------------------------------------------
+
+StatsReader::StatsReader(const std::string& name) {
+  const std::string path = ShmName(name);
+  const int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd < 0) Throw("cannot open shared memory", path);
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    Throw("cannot stat shared memory", path);
+  }
+  bytes_ = static_cast<std::size_t>(st.st_size);
+  if (bytes_ < SegmentBytes(0)) {
+    ::close(fd);
+    throw std::runtime_error("shared memory '" + path + "' is not a stats segment");
+  }
+  void* p = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) Throw("cannot map shared memory", path);
+  base_ = static_cast<std::uint64_t*>(p);
+
+  const bool ok = Word(base_, kMagicWord).load(std::memory_order_acquire) == kMagic &&
+                  Word(base_, kLayoutWord).load(std::memory_order_relaxed) == kLayout;
+  table_count_ = Word(base_, kCountWord).load(std::memory_order_relaxed);
+  if (!ok || SegmentBytes(table_count_) > bytes_) {
+    ::munmap(base_, bytes_);
+    base_ = nullptr;
+    throw std::runtime_error("shared memory '" + path + "' is not a stats segment");
+  }
+}
+
+StatsReader::~StatsReader() {
+  if (base_ != nullptr) ::munmap(base_, bytes_);
+}
+
+std::optional<StatsSnapshot> StatsReader::TryRead() const {
+  const std::uint64_t seq = Word(base_, kSeqWord).load(std::memory_order_acquire);
+  if (seq & 1u) return std::nullopt;
+
+  // Copy raw words first and decode only once the copy is known good.
+  std::vector<std::uint64_t> raw(table_count_ * kRecordWords);
+  std::uint64_t* recs = base_ + kHeaderWords;
+  for (std::size_t i = 0; i < raw.size(); ++i)
+    raw[i] = Word(recs, i).load(std::memory_order_relaxed);
+  const std::uint64_t queue = Word(base_, kQueueWord).load(std::memory_order_relaxed);
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (Word(base_, kSeqWord).load(std::memory_order_relaxed) != seq) return std::nullopt;
+
+  StatsSnapshot snap;
+  snap.version = seq / 2;
+  snap.queue_length = static_cast<std::size_t>(queue);
+  snap.tables.resize(table_count_);
+  for (std::size_t i = 0; i < table_count_; ++i) {
+    const std::uint64_t* rec = raw.data() + i * kRecordWords;
+    Table& t = snap.tables[i];
+    t.id = i + 1;
+    t.revenue = static_cast<std::uint32_t>(rec[kRevenueField]);
+    t.busy_minutes = static_cast<std::uint32_t>(rec[kBusyField]);
+    if (rec[kFlagsField] & kBusyFlag) {
+      const char* name = reinterpret_cast<const char*>(rec + kNameField);
+      t.occupant = std::string(name, ::strnlen(name, StatsPublisher::kMaxName));
+      t.occupied_since = Time{static_cast<std::uint16_t>(rec[kSinceField])};
+    }
+  }
+  return snap;
+}
+
+StatsSnapshot StatsReader::Read() const {
+  for (;;) {
+    if (auto snap = TryRead()) return *std::move(snap);
+    std::this_thread::yield();
+  }
+}
+
+}  // namespace cc
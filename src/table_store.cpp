@@ -0,0 +1,48 @@
+#include "table_store.hpp"
+
+namespace cc {
+
+TableStore::TableStore(const std::size_t count)
+    : busy_((count + 63) / 64, 0),
+      occupant_(count, kNoClient),
+      since_(count),
+      revenue_(count, 0),
+      busy_minutes_(count, 0),
+      dirty_bits_((count + 63) / 64, 0) {}
+
+void TableStore::Occupy(const std::size_t idx, const ClientId client, const Time time) {
+  if (!IsBusy(idx)) {
+    busy_[idx / 64] |= std::uint64_t{1} << (idx % 64);
+    ++busy_count_;
+  }
+  occupant_[idx] = client;
+  since_[idx] = time;
+  MarkDirty(idx);
+}
+
+std::uint16_t TableStore::Release(const std::size_t idx, const Time time,
+                                  const std::uint32_t hourly_price) {
+  const auto minutes = time - since_[idx];
+  busy_minutes_[idx] += minutes;
+  revenue_[idx] += hourly_price * MinutesToHoursRounded(minutes);
+  busy_[idx / 64] &= ~(std::uint64_t{1} << (idx % 64));
+  --busy_count_;
+  occupant_[idx] = kNoClient;
+  MarkDirty(idx);
+  return minutes;
+}
+
+void TableStore::MarkDirty(const std::size_t idx) {
+  std::uint64_t& word = dirty_bits_[idx / 64];
+  const std::uint64_t bit = std::uint64_t{1} << (idx % 64);
+  if (word & bit) return;
+  word |= bit;
+  dirty_.push_back(idx);
+}
+
+void TableStore::ClearDirty() {
+  for (const std::size_t idx : dirty_) dirty_bits_[idx / 64] = 0;
+  dirty_.clear();
+}
+
+}  // namespace cc
@@ -88,4 +88,148 @@ TEST(ClubRun, RemainingClientsDroppedAtClose)
     }
     EXPECT_TRUE(sawOutgoingLeftForEve);
     EXPECT_TRUE(sawOutgoingLeftForFrank);
-}
\ No newline at end of file
+}
+
+TEST(ClubRun, WaitingClientWhoLeftIsNotSeated)
+{
+    cc::Config cfg{1u, cc::Time{0u}, cc::Time{200u}, 5u};
+    cc::Club club(cfg);
+
+    std::vector<cc::IncomingEvent> events{
+        {cc::Time{10u}, cc::EventId::kClientArrived, {"Bob"}},
+        {cc::Time{10u}, cc::EventId::kClientSeated, {"Bob", "1"}},
+        {cc::Time{20u}, cc::EventId::kClientArrived, {"Carol"}},
+        {cc::Time{20u}, cc::EventId::kClientWaiting, {"Carol"}},
+        {cc::Time{30u}, cc::EventId::kClientLeft, {"Carol"}},
+        {cc::Time{50u}, cc::EventId::kClientLeft, {"Bob"}}
+    };
+    std::vector<cc::OutgoingEvent> log;
+    club.Run(events, log);
+
+    for (auto& e : log)
+        EXPECT_NE(e.id, cc::EventId::kOutgoingSeated);
+    EXPECT_FALSE(club.tables()[0].IsBusy());
+}
+
+TEST(ClubRun, SeatedClientWhoAlsoWaitsIsNotReseatedAfterLeaving)
+{
+    cc::Config cfg{1u, cc::Time{0u}, cc::Time{200u}, 5u};
+    cc::Club club(cfg);
+
+    std::vector<cc::IncomingEvent> events{
+        {cc::Time{10u}, cc::EventId::kClientArrived, {"Bob"}},
+        {cc::Time{10u}, cc::EventId::kClientSeated, {"Bob", "1"}},
+        {cc::Time{10u}, cc::EventId::kClientWaiting, {"Bob"}},
+        {cc::Time{10u}, cc::EventId::kClientLeft, {"Bob"}}
+    };
+    std::vector<cc::OutgoingEvent> log;
+    club.Run(events, log);
+
+    for (auto& e : log)
+        EXPECT_NE(e.id, cc::EventId::kOutgoingSeated);
+    EXPECT_FALSE(club.tables()[0].IsBusy());
+}
+
+// Outgoing events as "HH:MM id payload", like the printed log.
+static std::vector<std::string> Lines(const std::vector<cc::OutgoingEvent>& log)
+{
+    std::vector<std::string> out;
+    for (auto& e : log) {
+        if (e.id == cc::EventId::kError && e.payload.empty())
+            out.push_back(e.time.ToString());  // opening / closing line
+        else
+            out.push_back(e.time.ToString() + ' ' + std::to_string(static_cast<int>(e.id)) +
+                          ' ' + e.payload);
+    }
+    return out;
+}
+
+TEST(ClubRun, DepartedWaiterFreesQueueSlot)
+{
+    // One table, so one queue slot. Carol gives up; Dave takes her slot
+    // instead of being sent away, and gets the table when Bob leaves.
+    cc::Config cfg{1u, cc::Time{0u}, cc::Time{200u}, 5u};
+    cc::Club club(cfg);
+
+    std::vector<cc::IncomingEvent> events{
+        {cc::Time{10u}, cc::EventId::kClientArrived, {"Bob"}},
+        {cc::Time{10u}, cc::EventId::kClientSeated, {"Bob", "1"}},
+        {cc::Time{20u}, cc::EventId::kClientArrived, {"Carol"}},
+        {cc::Time{20u}, cc::EventId::kClientWaiting, {"Carol"}},
+        {cc::Time{30u}, cc::EventId::kClientLeft, {"Carol"}},
+        {cc::Time{40u}, cc::EventId::kClientArrived, {"Dave"}},
+        {cc::Time{40u}, cc::EventId::kClientWaiting, {"Dave"}},
+        {cc::Time{50u}, cc::EventId::kClientLeft, {"Bob"}}
+    };
+    std::vector<cc::OutgoingEvent> log;
+    club.Run(events, log);
+
+    const std::vector<std::string> expected{
+        "00:00",
+        "00:10 1 Bob", "00:10 2 Bob 1",
+        "00:20 1 Carol", "00:20 3 Carol",
+        "00:30 4 Carol",
+        "00:40 1 Dave", "00:40 3 Dave",
+        "00:50 4 Bob", "00:50 12 Dave 1",
+        "03:20 11 Dave",
+        "03:20"
+    };
+    EXPECT_EQ(Lines(log), expected);
+}
+
+TEST(ClubRun, ClientDroppedAtCloseIsNotSeated)
+{
+    // Alice waits for Zed's table. At close Alice is dropped first (names
+    // are sorted), so Zed's table is not handed to her afterwards.
+    cc::Config cfg{1u, cc::Time{0u}, cc::Time{200u}, 5u};
+    cc::Club club(cfg);
+
+    std::vector<cc::IncomingEvent> events{
+        {cc::Time{10u}, cc::EventId::kClientArrived, {"Zed"}},
+        {cc::Time{10u}, cc::EventId::kClientSeated, {"Zed", "1"}},
+        {cc::Time{20u}, cc::EventId::kClientArrived, {"Alice"}},
+        {cc::Time{20u}, cc::EventId::kClientWaiting, {"Alice"}},
+        {cc::Time{20u}, cc::EventId::kClientWaiting, {"Alice"}}  // second slot overflows
+    };
+    std::vector<cc::OutgoingEvent> log;
+    club.Run(events, log);
+
+    const std::vector<std::string> expected{
+        "00:00",
+        "00:10 1 Zed", "00:10 2 Zed 1",
+        "00:20 1 Alice", "00:20 3 Alice",
+        "00:20 3 Alice", "00:20 11 Alice",
+        "03:20 11 Zed",
+        "03:20"
+    };
+    EXPECT_EQ(Lines(log), expected);
+    EXPECT_FALSE(club.tables()[0].IsBusy());
+}
+
+TEST(ClubRun, CustomSchedulerPicksVipFirst)
+{
+    cc::Config cfg{1u, cc::Time{0u}, cc::Time{200u}, 5u};
+    cc::Club club(cfg, std::make_unique<cc::PriorityScheduler>(
+                           2u, std::unordered_map<std::string, std::uint32_t>{{"Vip", 1u}}));
+
+    std::vector<cc::IncomingEvent> events{
+        {cc::Time{10u}, cc::EventId::kClientArrived, {"Bob"}},
+        {cc::Time{10u}, cc::EventId::kClientSeated, {"Bob", "1"}},
+        {cc::Time{20u}, cc::EventId::kClientArrived, {"Carol"}},
+        {cc::Time{20u}, cc::EventId::kClientWaiting, {"Carol"}},
+        {cc::Time{25u}, cc::EventId::kClientArrived, {"Vip"}},
+        {cc::Time{25u}, cc::EventId::kClientWaiting, {"Vip"}},
+        {cc::Time{50u}, cc::EventId::kClientLeft, {"Bob"}}
+    };
+    std::vector<cc::OutgoingEvent> log;
+    club.Run(events, log);
+
+    bool sawVipSeated = false;
+    for (auto& e : log) {
+        if (e.id == cc::EventId::kOutgoingSeated) {
+            EXPECT_EQ(e.payload, "Vip 1");
+            sawVipSeated = true;
+        }
+    }
+    EXPECT_TRUE(sawVipSeated);
+}
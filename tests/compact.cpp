@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "club.hpp"
+#include "compact.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace cc;
+
+namespace {
+
+Config kCfg{3u, Time{9 * 60}, Time{19 * 60}, 10u};
+
+// The sample day from input.txt plus a few events that change nothing.
+std::vector<IncomingEvent> SampleDay() {
+    return {
+        {Time{8 * 60 + 48}, EventId::kClientArrived, {"client1"}},   // NotOpenYet
+        {Time{9 * 60 + 41}, EventId::kClientArrived, {"client1"}},
+        {Time{9 * 60 + 42}, EventId::kClientArrived, {"client1"}},   // YouShallNotPass
+        {Time{9 * 60 + 48}, EventId::kClientArrived, {"client2"}},
+        {Time{9 * 60 + 52}, EventId::kClientWaiting, {"client1"}},   // ICanWaitNoLonger!
+        {Time{9 * 60 + 53}, EventId::kClientSeated, {"ghost", "1"}}, // ClientUnknown
+        {Time{9 * 60 + 54}, EventId::kClientSeated, {"client1", "1"}},
+        {Time{10 * 60 + 25}, EventId::kClientSeated, {"client2", "2"}},
+        {Time{10 * 60 + 58}, EventId::kClientArrived, {"client3"}},
+        {Time{10 * 60 + 59}, EventId::kClientSeated, {"client3", "3"}},
+        {Time{11 * 60}, EventId::kClientArrived, {"idle"}},          // never sits
+        {Time{11 * 60 + 30}, EventId::kClientArrived, {"client4"}},
+        {Time{11 * 60 + 35}, EventId::kClientSeated, {"client4", "2"}},  // PlaceIsBusy
+        {Time{11 * 60 + 45}, EventId::kClientWaiting, {"client4"}},
+        {Time{12 * 60 + 33}, EventId::kClientLeft, {"client1"}},
+        {Time{12 * 60 + 40}, EventId::kClientLeft, {"nobody"}},      // not inside
+        {Time{12 * 60 + 43}, EventId::kClientLeft, {"client2"}},
+        {Time{13 * 60}, EventId::kClientLeft, {"idle"}},
+        {Time{15 * 60 + 52}, EventId::kClientLeft, {"client4"}},
+    };
+}
+
+std::vector<OutgoingEvent> Replay(const std::vector<IncomingEvent>& events,
+                                  std::vector<Table>& tables) {
+    Club club(kCfg);
+    std::vector<OutgoingEvent> log;
+    club.Run(events, log);
+    tables = club.tables();
+    return log;
+}
+
+// Events generated by the club itself, i.e. neither echoes nor errors.
+std::vector<std::string> Generated(const std::vector<OutgoingEvent>& log) {
+    std::vector<std::string> out;
+    for (const auto& e : log) {
+        if (e.id == EventId::kOutgoingLeft || e.id == EventId::kOutgoingSeated)
+            out.push_back(e.time.ToString() + ' ' + std::to_string(static_cast<int>(e.id)) +
+                          ' ' + e.payload);
+    }
+    return out;
+}
+
+void ExpectSameStats(const std::vector<Table>& a, const std::vector<Table>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].revenue, b[i].revenue) << "table " << a[i].id;
+        EXPECT_EQ(a[i].busy_minutes, b[i].busy_minutes) << "table " << a[i].id;
+    }
+}
+
+}  // namespace
+
+TEST(Compact, KeepEventsPreservesStatsAndGeneratedEvents) {
+    const auto events = SampleDay();
+    const auto compacted = Compact(kCfg, events, CompactMode::kEvents);
+    EXPECT_EQ(compacted.size(), events.size() - 6);
+
+    std::vector<Table> full_tables, compact_tables;
+    const auto full = Replay(events, full_tables);
+    const auto compact = Replay(compacted, compact_tables);
+
+    ExpectSameStats(full_tables, compact_tables);
+    EXPECT_EQ(Generated(full), Generated(compact));
+    for (const auto& e : compact) EXPECT_TRUE(e.id != EventId::kError || e.payload.empty());
+}
+
+TEST(Compact, StatsModeDropsClientsWhoNeverSat) {
+    const auto events = SampleDay();
+    const auto compacted = Compact(kCfg, events, CompactMode::kStats);
+    for (const auto& e : compacted) EXPECT_NE(e.payload[0], "idle");
+    EXPECT_EQ(compacted.size(), events.size() - 8);
+
+    std::vector<Table> full_tables, compact_tables;
+    Replay(events, full_tables);
+    Replay(compacted, compact_tables);
+    ExpectSameStats(full_tables, compact_tables);
+}
+
+TEST(Compact, QueueOverflowVictimDroppedInStatsMode) {
+    const Config cfg{1u, Time{0u}, Time{100u}, 1u};
+    const std::vector<IncomingEvent> events{
+        {Time{5u}, EventId::kClientArrived, {"a"}},
+        {Time{5u}, EventId::kClientSeated, {"a", "1"}},
+        {Time{10u}, EventId::kClientArrived, {"b"}},
+        {Time{10u}, EventId::kClientWaiting, {"b"}},
+        {Time{15u}, EventId::kClientArrived, {"c"}},
+        {Time{15u}, EventId::kClientWaiting, {"c"}},  // overflow
+    };
+    EXPECT_EQ(Compact(cfg, events, CompactMode::kEvents).size(), 6u);
+    EXPECT_EQ(Compact(cfg, events, CompactMode::kStats).size(), 4u);
+}
+
+TEST(Compact, WriteInputRoundTripsThroughParser) {
+    ParsedInput in{kCfg, Compact(kCfg, SampleDay(), CompactMode::kEvents)};
+    const auto path = std::filesystem::temp_directory_path() / "compact_roundtrip.txt";
+    {
+        std::ofstream ofs(path);
+        WriteInput(in, ofs);
+    }
+    const auto back = ParseFile(path);
+    EXPECT_EQ(back.cfg.table_count, kCfg.table_count);
+    EXPECT_EQ(back.cfg.open_time, kCfg.open_time);
+    EXPECT_EQ(back.cfg.close_time, kCfg.close_time);
+    EXPECT_EQ(back.cfg.hourly_price, kCfg.hourly_price);
+    ASSERT_EQ(back.events.size(), in.events.size());
+    for (std::size_t i = 0; i < in.events.size(); ++i) {
+        EXPECT_EQ(back.events[i].time, in.events[i].time);
+        EXPECT_EQ(back.events[i].id, in.events[i].id);
+        EXPECT_EQ(back.events[i].payload, in.events[i].payload);
+    }
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "follow.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace cc;
+
+namespace {
+
+std::filesystem::path fresh_tmp(const std::string& name) {
+    auto p = std::filesystem::temp_directory_path() / name;
+    std::ofstream(p, std::ios::trunc);
+    return p;
+}
+
+void append(const std::filesystem::path& p, const std::string& text) {
+    std::ofstream ofs(p, std::ios::app | std::ios::binary);
+    ofs << text;
+}
+
+std::vector<std::string> Lines(const std::vector<OutgoingEvent>& log) {
+    std::vector<std::string> out;
+    for (const auto& e : log)
+        out.push_back(e.time.ToString() + ' ' + std::to_string(static_cast<int>(e.id)) + ' ' +
+                      e.payload);
+    return out;
+}
+
+const std::string kDay =
+    "3\n09:00 19:00\n10\n"
+    "08:48 1 client1\n"
+    "09:41 1 client1\n"
+    "09:48 1 client2\n"
+    "09:52 3 client1\n"
+    "09:54 2 client1 1\n"
+    "\n"
+    "10:25 2 client2 2\n"
+    "10:58 1 client3\n"
+    "10:59 2 client3 3\n"
+    "11:30 1 client4\n"
+    "11:35 2 client4 2\n"
+    "11:45 3 client4\n"
+    "12:33 4 client1\n"
+    "12:43 4 client2\n"
+    "15:52 4 client4";  // no trailing newline
+
+}  // namespace
+
+TEST(Follower, IncrementalPollsMatchBatchRun) {
+    const auto path = fresh_tmp("follow_day.txt");
+    Follower follower(path);
+    std::vector<OutgoingEvent> log;
+
+    // Feed the day in uneven pieces, often splitting lines mid-way.
+    for (std::size_t pos = 0; pos < kDay.size(); pos += 7) {
+        append(path, kDay.substr(pos, 7));
+        follower.Poll(log);
+    }
+    EXPECT_FALSE(follower.finished());
+    EXPECT_EQ(follower.offset(), kDay.size());
+    follower.Finish(log);
+    EXPECT_TRUE(follower.finished());
+    EXPECT_EQ(follower.line_no(), 18u);
+
+    const auto parsed = ParseFile(path);
+    Club batch(parsed.cfg);
+    std::vector<OutgoingEvent> expected;
+    batch.Run(parsed.events, expected);
+    EXPECT_EQ(Lines(log), Lines(expected));
+
+    const auto a = follower.club().tables();
+    const auto b = batch.tables();
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].revenue, b[i].revenue);
+        EXPECT_EQ(a[i].busy_minutes, b[i].busy_minutes);
+    }
+}
+
+TEST(Follower, PollReturnsOnlyNewEvents) {
+    const auto path = fresh_tmp("follow_new.txt");
+    Follower follower(path);
+    std::vector<OutgoingEvent> log;
+
+    EXPECT_FALSE(follower.Poll(log));
+    append(path, "1\n08:00 18:00\n10\n09:00 1 alice\n");
+    EXPECT_TRUE(follower.Poll(log));
+    ASSERT_TRUE(follower.config());
+    EXPECT_EQ(Lines(log), (std::vector<std::string>{"08:00 13 ", "09:00 1 alice"}));
+
+    log.clear();
+    append(path, "09:05 2 ali");
+    EXPECT_FALSE(follower.Poll(log));  // incomplete line is held back
+    EXPECT_TRUE(log.empty());
+    append(path, "ce 1\n");
+    EXPECT_TRUE(follower.Poll(log));
+    EXPECT_EQ(Lines(log), (std::vector<std::string>{"09:05 2 alice 1"}));
+    EXPECT_TRUE(follower.club().tables()[0].IsBusy());
+}
+
+TEST(Follower, ErrorsKeepOriginalLineNumbers) {
+    const auto path = fresh_tmp("follow_error.txt");
+    Follower follower(path);
+    std::vector<OutgoingEvent> log;
+    append(path, "1\n\n08:00 18:00\n10\n09:00 1 alice\n");
+    follower.Poll(log);
+    append(path, "\n09:05 7 alice\n");
+    try {
+        follower.Poll(log);
+        FAIL() << "expected ValidationError";
+    } catch (const ValidationError& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("Line 7:", 0), 0u) << e.what();
+    }
+}
+
+TEST(Follower, IncompleteHeaderAtFinishThrows) {
+    const auto path = fresh_tmp("follow_header.txt");
+    Follower follower(path);
+    std::vector<OutgoingEvent> log;
+    append(path, "1\n08:00 18:00\n");
+    EXPECT_THROW(follower.Finish(log), ValidationError);
+}
+
+TEST(Follower, TruncationIsDetected) {
+    const auto path = fresh_tmp("follow_truncate.txt");
+    Follower follower(path);
+    std::vector<OutgoingEvent> log;
+    append(path, "1\n08:00 18:00\n10\n");
+    follower.Poll(log);
+    std::ofstream(path, std::ios::trunc);
+    EXPECT_THROW(follower.Poll(log), std::runtime_error);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "line_reader.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace cc;
+
+namespace {
+
+std::filesystem::path write_tmp(const std::string& name, const std::string& text) {
+    auto p = std::filesystem::temp_directory_path() / name;
+    std::ofstream ofs(p, std::ios::binary);
+    ofs << text;
+    return p;
+}
+
+// Reference result: what std::getline would produce.
+std::vector<std::string> getline_all(const std::string& text) {
+    std::istringstream in(text);
+    std::vector<std::string> out;
+    for (std::string l; std::getline(in, l);) out.push_back(l);
+    return out;
+}
+
+}  // namespace
+
+TEST(LineReader, MatchesGetlineForEveryBlockSize) {
+    const std::string text =
+        "3\n09:00 19:00\n\n10\n08:48 1 client1\n09:41 1 a_rather_long_client_name\n\n\nlast";
+    const auto path = write_tmp("line_reader_blocks.txt", text);
+    const auto expected = getline_all(text);
+
+    for (std::size_t block = 1; block <= text.size() + 1; ++block) {
+        LineReader in(path, block);
+        std::vector<std::string> got;
+        for (std::string l; in.Next(l);) {
+            got.push_back(l);
+            EXPECT_EQ(in.line_no(), got.size()) << "block " << block;
+        }
+        EXPECT_EQ(got, expected) << "block " << block;
+    }
+}
+
+TEST(LineReader, TrailingNewlineDoesNotAddEmptyLine) {
+    const auto path = write_tmp("line_reader_trailing.txt", "a\nb\n");
+    LineReader in(path, 3);
+    std::string l;
+    ASSERT_TRUE(in.Next(l));
+    EXPECT_EQ(l, "a");
+    ASSERT_TRUE(in.Next(l));
+    EXPECT_EQ(l, "b");
+    EXPECT_FALSE(in.Next(l));
+    EXPECT_FALSE(in.Next(l));
+    EXPECT_EQ(in.line_no(), 2u);
+}
+
+TEST(LineReader, EmptyFile) {
+    const auto path = write_tmp("line_reader_empty.txt", "");
+    LineReader in(path);
+    std::string l;
+    EXPECT_FALSE(in.Next(l));
+    EXPECT_EQ(in.line_no(), 0u);
+}
+
+TEST(LineReader, MissingFileThrows) {
+    EXPECT_THROW(LineReader("nonexistent_file.txt"), std::runtime_error);
+}
+
+TEST(LineReader, EarlyDestructionJoinsWorker) {
+    std::string text;
+    for (int i = 0; i < 10000; ++i) text += "09:00 1 client" + std::to_string(i) + '\n';
+    const auto path = write_tmp("line_reader_early.txt", text);
+    LineReader in(path, 64);
+    std::string l;
+    ASSERT_TRUE(in.Next(l));
+    EXPECT_EQ(l, "09:00 1 client0");
+}
+
+TEST(LineReader, DestroyOverOpenPipeDoesNotBlock) {
+    const auto path = std::filesystem::temp_directory_path() / "line_reader_fifo";
+    std::filesystem::remove(path);
+    ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+    // O_RDWR does not wait for a reader; the writer stays open throughout.
+    const int writer = ::open(path.c_str(), O_RDWR);
+    ASSERT_GE(writer, 0);
+    const std::string text = "1\n09:00 19:00\n";
+    ASSERT_EQ(::write(writer, text.data(), text.size()), static_cast<ssize_t>(text.size()));
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        LineReader in(path);
+        std::string l;
+        ASSERT_TRUE(in.Next(l));
+        EXPECT_EQ(l, "1");
+        ASSERT_TRUE(in.Next(l));
+        EXPECT_EQ(l, "09:00 19:00");
+    }  // more input may follow, but the reader is abandoned here
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    ::close(writer);
+    std::filesystem::remove(path);
+}
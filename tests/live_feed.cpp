@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "live_feed.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace cc;
+
+namespace {
+
+const std::string kDay =
+    "2\n09:00 19:00\n10\n"
+    "09:10 1 alice\n"
+    "09:10 2 alice 1\n"
+    "\n"
+    "10:00 1 bob\n"
+    "10:05 2 bob 2\n"
+    "11:00 4 alice";  // last line without '\n'
+
+std::filesystem::path write_tmp(const std::string& name, const std::string& text) {
+    auto p = std::filesystem::temp_directory_path() / name;
+    std::ofstream ofs(p, std::ios::binary);
+    ofs << text;
+    return p;
+}
+
+// Collects outgoing events per input, as printed by 'task live'.
+struct Collected {
+    std::mutex mu;
+    std::map<std::size_t, std::vector<std::string>> lines;
+
+    LiveFeed::SinkFactory Factory() {
+        return [this](const std::size_t i) -> EventSink {
+            return [this, i](const OutgoingEvent& ev) {
+                std::lock_guard lock(mu);
+                lines[i].push_back(ev.time.ToString() + ' ' + ev.payload);
+            };
+        };
+    }
+};
+
+}  // namespace
+
+TEST(LiveFeed, MatchesClubRunAndReportsPerInputErrors) {
+    const auto good = write_tmp("live_feed_good.txt", kDay);
+    const auto bad = write_tmp("live_feed_bad.txt", "1\n09:00 19:00\n10\n09:01 7 x\n");
+    const auto eof = write_tmp("live_feed_eof.txt", "1\n09:00 19:00\n");
+
+    Runtime rt(2);
+    Collected out;
+    LiveFeed feed(rt, {good, bad, eof, "nonexistent_live_feed.txt"}, out.Factory());
+    feed.Run();
+    rt.Wait();
+
+    const auto expected = ParseFile(good);
+    Club club(expected.cfg);
+    std::vector<OutgoingEvent> log;
+    club.Run(expected.events, log);
+
+    ASSERT_NE(feed.club(0), nullptr);
+    EXPECT_TRUE(feed.error(0).empty()) << feed.error(0);
+    ASSERT_EQ(out.lines[0].size(), log.size());
+    for (std::size_t i = 0; i < log.size(); ++i)
+        EXPECT_EQ(out.lines[0][i], log[i].time.ToString() + ' ' + log[i].payload);
+    ASSERT_EQ(feed.club(0)->tables().size(), 2u);
+    EXPECT_EQ(feed.club(0)->tables()[0].revenue, club.tables()[0].revenue);
+    EXPECT_EQ(feed.club(0)->tables()[1].busy_minutes, club.tables()[1].busy_minutes);
+
+    EXPECT_EQ(feed.error(1).rfind("Line 4:", 0), 0u) << feed.error(1);
+    EXPECT_EQ(feed.club(2), nullptr);
+    EXPECT_EQ(feed.error(2), "Line 3: unexpected EOF");
+    EXPECT_EQ(feed.club(3), nullptr);
+    EXPECT_FALSE(feed.error(3).empty());
+}
+
+TEST(LiveFeed, FifoWithLateWriter) {
+    const auto path = std::filesystem::temp_directory_path() / "live_feed_fifo";
+    std::filesystem::remove(path);
+    ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+
+    Runtime rt(1);
+    Collected out;
+    LiveFeed feed(rt, {path}, out.Factory());  // must not wait for a writer
+
+    std::thread writer([&] {
+        const int fd = ::open(path.c_str(), O_WRONLY);
+        ASSERT_GE(fd, 0);
+        // Split mid-line to exercise the partial-line buffer.
+        const std::size_t half = kDay.size() / 2;
+        ASSERT_EQ(::write(fd, kDay.data(), half), static_cast<ssize_t>(half));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ASSERT_EQ(::write(fd, kDay.data() + half, kDay.size() - half),
+                  static_cast<ssize_t>(kDay.size() - half));
+        ::close(fd);
+    });
+    feed.Run();
+    writer.join();
+    rt.Wait();
+
+    EXPECT_TRUE(feed.error(0).empty()) << feed.error(0);
+    ASSERT_NE(feed.club(0), nullptr);
+    EXPECT_EQ(out.lines[0].front(), "09:00 ");
+    EXPECT_EQ(out.lines[0].back(), "19:00 ");
+    EXPECT_FALSE(feed.club(0)->tables()[1].IsBusy());
+    std::filesystem::remove(path);
+}
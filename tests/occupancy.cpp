@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include "club.hpp"
+#include "occupancy.hpp"
+#include <map>
+#include <sstream>
+
+using namespace cc;
+
+namespace {
+
+// Two tables: bob at 1 during 10..50, dan at 2 during 15..60, carol waits
+// during 20..50 and then takes table 1 until close at 100.
+OccupancyIndex SampleIndex() {
+    Config cfg{2u, Time{0u}, Time{100u}, 5u};
+    Club club(cfg);
+    std::vector<IncomingEvent> events{
+        {Time{10u}, EventId::kClientArrived, {"bob"}},
+        {Time{10u}, EventId::kClientSeated, {"bob", "1"}},
+        {Time{15u}, EventId::kClientArrived, {"dan"}},
+        {Time{15u}, EventId::kClientSeated, {"dan", "2"}},
+        {Time{20u}, EventId::kClientArrived, {"carol"}},
+        {Time{20u}, EventId::kClientWaiting, {"carol"}},
+        {Time{50u}, EventId::kClientLeft, {"bob"}},
+        {Time{60u}, EventId::kClientLeft, {"dan"}},
+    };
+    std::vector<OutgoingEvent> log;
+    club.Run(events, log);
+    return OccupancyIndex(club);
+}
+
+}  // namespace
+
+TEST(Occupancy, PointQueries) {
+    const auto idx = SampleIndex();
+
+    EXPECT_FALSE(idx.IsBusy(1, Time{9u}));
+    EXPECT_EQ(idx.OccupantAt(1, Time{10u}), "bob");
+    EXPECT_EQ(idx.OccupantAt(1, Time{49u}), "bob");
+    EXPECT_EQ(idx.OccupantAt(1, Time{50u}), "carol");
+    EXPECT_EQ(idx.OccupantAt(1, Time{99u}), "carol");
+    EXPECT_EQ(idx.OccupantAt(1, Time{100u}), std::nullopt);
+    EXPECT_EQ(idx.OccupantAt(2, Time{60u}), std::nullopt);
+
+    EXPECT_EQ(idx.BusyCount(Time{30u}), 2u);
+    EXPECT_EQ(idx.BusyCount(Time{70u}), 1u);
+    const auto busy = idx.BusyAt(Time{30u});
+    ASSERT_EQ(busy.size(), 2u);
+    EXPECT_EQ(busy[0], (std::pair<std::size_t, std::string>{1, "bob"}));
+    EXPECT_EQ(busy[1], (std::pair<std::size_t, std::string>{2, "dan"}));
+
+    EXPECT_EQ(idx.WaitingAt(Time{19u}), 0u);
+    EXPECT_EQ(idx.WaitingAt(Time{20u}), 1u);
+    EXPECT_EQ(idx.WaitingAt(Time{50u}), 0u);
+}
+
+TEST(Occupancy, RangeQueries) {
+    const auto idx = SampleIndex();
+    EXPECT_EQ(idx.TablesBusyDuring(Time{0u}, Time{12u}), (std::vector<std::size_t>{1}));
+    EXPECT_EQ(idx.TablesBusyDuring(Time{60u}, Time{200u}), (std::vector<std::size_t>{1}));
+    EXPECT_EQ(idx.TablesBusyDuring(Time{0u}, Time{1439u}), (std::vector<std::size_t>{1, 2}));
+    EXPECT_TRUE(idx.TablesBusyDuring(Time{0u}, Time{10u}).empty());
+    EXPECT_EQ(idx.MaxWaiting(Time{0u}, Time{100u}), 1u);
+    EXPECT_EQ(idx.MaxWaiting(Time{50u}, Time{100u}), 0u);
+}
+
+TEST(Occupancy, SaveLoadRoundTrip) {
+    const auto idx = SampleIndex();
+    std::stringstream ss;
+    idx.Save(ss);
+    const auto back = OccupancyIndex::Load(ss);
+
+    EXPECT_EQ(back.table_count(), idx.table_count());
+    for (std::uint16_t m = 0; m < 120; ++m) {
+        EXPECT_EQ(back.BusyAt(Time{m}), idx.BusyAt(Time{m}));
+        EXPECT_EQ(back.WaitingAt(Time{m}), idx.WaitingAt(Time{m}));
+    }
+}
+
+TEST(Occupancy, LoadRejectsGarbage) {
+    std::istringstream bad("not an index");
+    EXPECT_THROW(OccupancyIndex::Load(bad), std::runtime_error);
+    std::istringstream truncated("occupancy 1\n2\n1\n1 00:10");
+    EXPECT_THROW(OccupancyIndex::Load(truncated), std::runtime_error);
+}
+
+namespace {
+
+// Replays `events` step by step and checks that the index built after
+// Close() reports, for every table, the occupant the live club had from
+// each event minute on. Returns the index for further checks.
+OccupancyIndex ExpectIndexMatchesClub(const Config& cfg,
+                                      const std::vector<IncomingEvent>& events) {
+    Club club(cfg);
+    std::vector<OutgoingEvent> log;
+    std::map<std::uint16_t, std::vector<Table>> live;  // state after each minute
+    club.Open(log);
+    for (const auto& ev : events) {
+        club.Process(ev, log);
+        live[ev.time.minutes()] = club.tables();
+    }
+    club.Close(log);
+    OccupancyIndex idx(club);
+
+    for (auto it = live.begin(); it != live.end(); ++it) {
+        const auto next = std::next(it);
+        const std::uint16_t end = next == live.end() ? cfg.close_time.minutes() : next->first;
+        for (std::uint16_t m = it->first; m < end; ++m) {
+            for (const auto& t : it->second)
+                EXPECT_EQ(idx.OccupantAt(t.id, Time{m}), t.occupant) << "table " << t.id
+                                                                     << " minute " << m;
+        }
+    }
+
+    // After Close() every table is free and billed, so nothing is missing.
+    std::vector<std::uint32_t> minutes(cfg.table_count, 0);
+    for (const auto& s : club.sessions()) minutes[s.table_id - 1] += s.to - s.from;
+    for (const auto& t : club.tables()) {
+        EXPECT_FALSE(t.IsBusy()) << "table " << t.id;
+        EXPECT_EQ(minutes[t.id - 1], t.busy_minutes) << "table " << t.id;
+    }
+    return idx;
+}
+
+}  // namespace
+
+TEST(Occupancy, AgreesWithClubWhenSeatedClientAlsoWaits) {
+    // One table: bob sits, queues while seated, then leaves; carol takes
+    // the table later. She queues behind dan while seated and overflows,
+    // so her table goes to dan.
+    const auto idx = ExpectIndexMatchesClub(
+        Config{1u, Time{0u}, Time{100u}, 5u},
+        {
+            {Time{10u}, EventId::kClientArrived, {"bob"}},
+            {Time{10u}, EventId::kClientSeated, {"bob", "1"}},
+            {Time{10u}, EventId::kClientWaiting, {"bob"}},
+            {Time{20u}, EventId::kClientLeft, {"bob"}},
+            {Time{30u}, EventId::kClientArrived, {"carol"}},
+            {Time{30u}, EventId::kClientSeated, {"carol", "1"}},
+            {Time{35u}, EventId::kClientArrived, {"dan"}},
+            {Time{35u}, EventId::kClientWaiting, {"dan"}},
+            {Time{40u}, EventId::kClientWaiting, {"carol"}},
+        });
+
+    EXPECT_EQ(idx.OccupantAt(1, Time{25u}), std::nullopt);
+    EXPECT_EQ(idx.OccupantAt(1, Time{39u}), "carol");
+    EXPECT_EQ(idx.OccupantAt(1, Time{99u}), "dan");
+    EXPECT_EQ(idx.WaitingAt(Time{15u}), 1u);
+    EXPECT_EQ(idx.WaitingAt(Time{20u}), 0u);
+    EXPECT_EQ(idx.WaitingAt(Time{37u}), 1u);
+    EXPECT_EQ(idx.WaitingAt(Time{40u}), 0u);
+}
+
+TEST(Occupancy, AgreesWithClubWhenQueuedClientMovesTables) {
+    // Two tables: bob at 2 and carol at 1 both queue while seated. Carol
+    // overflows and leaves; her table goes to bob, who gives up table 2.
+    const auto idx = ExpectIndexMatchesClub(
+        Config{2u, Time{0u}, Time{100u}, 5u},
+        {
+            {Time{10u}, EventId::kClientArrived, {"bob"}},
+            {Time{10u}, EventId::kClientSeated, {"bob", "2"}},
+            {Time{12u}, EventId::kClientArrived, {"carol"}},
+            {Time{12u}, EventId::kClientSeated, {"carol", "1"}},
+            {Time{20u}, EventId::kClientWaiting, {"bob"}},
+            {Time{21u}, EventId::kClientWaiting, {"carol"}},
+            {Time{30u}, EventId::kClientWaiting, {"carol"}},
+        });
+
+    EXPECT_EQ(idx.OccupantAt(1, Time{30u}), "bob");
+    EXPECT_EQ(idx.OccupantAt(2, Time{30u}), std::nullopt);
+    EXPECT_EQ(idx.OccupantAt(2, Time{29u}), "bob");
+}
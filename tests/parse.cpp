@@ -116,4 +116,73 @@ TEST(Parser, TableIdOutOfRangeThrows) {
                           "1\n08:00 18:00\n10\n"
                           "09:00 1 alice 2\n");
     EXPECT_THROW(ParseFile(path), std::runtime_error);
-}
\ No newline at end of file
+}
+
+TEST(Parser, ErrorReportsOriginalLineNumber) {
+    const auto path = write_tmp("error_line_number.txt",
+                          "1\n\n08:00 18:00\n10\n\n"
+                          "09:00 1 alice\n"
+                          "\n"
+                          "09:05 7 alice\n");
+    try {
+        ParseFile(path);
+        FAIL() << "expected ValidationError";
+    } catch (const ValidationError& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("Line 8:", 0), 0u) << e.what();
+    }
+}
+
+TEST(StreamParser, ByteByByteMatchesParseFile) {
+    const std::string text = "2\n\n08:00 18:00\n10\n"
+                             "09:00 1 alice\n"
+                             "\n"
+                             "09:05 2 alice 2\n"
+                             "09:30 4 alice";  // last line without '\n'
+    const auto expected = ParseFile(write_tmp("stream_parser.txt", text));
+
+    StreamParser parser;
+    std::vector<IncomingEvent> got;
+    IncomingEvent ev;
+    for (const char c : text) {
+        parser.Feed(std::string_view(&c, 1));
+        while (parser.Next(ev)) got.push_back(ev);
+    }
+    EXPECT_EQ(got.size(), 2u);  // the unterminated line waits for Finish()
+    ASSERT_TRUE(parser.config());
+    EXPECT_EQ(parser.config()->table_count, 2u);
+
+    parser.Finish();
+    while (parser.Next(ev)) got.push_back(ev);
+    ASSERT_EQ(got.size(), expected.events.size());
+    for (std::size_t i = 0; i < got.size(); ++i) {
+        EXPECT_EQ(got[i].time, expected.events[i].time);
+        EXPECT_EQ(got[i].payload, expected.events[i].payload);
+    }
+    EXPECT_EQ(parser.line_no(), 8u);
+}
+
+TEST(StreamParser, ErrorsMatchParseFile) {
+    StreamParser truncated;
+    truncated.Feed("1\n09:00 19:00\n");
+    IncomingEvent ev;
+    EXPECT_FALSE(truncated.Next(ev));
+    EXPECT_FALSE(truncated.config());
+    truncated.Finish();
+    try {
+        truncated.Next(ev);
+        FAIL() << "expected ValidationError";
+    } catch (const ValidationError& e) {
+        EXPECT_STREQ(e.what(), "Line 3: unexpected EOF");
+    }
+
+    StreamParser bad;
+    bad.Feed("1\n09:00 19:00\n10\n\n09:0");
+    EXPECT_FALSE(bad.Next(ev));
+    bad.Feed("1 7 alice\n");
+    try {
+        bad.Next(ev);
+        FAIL() << "expected ValidationError";
+    } catch (const ValidationError& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("Line 5:", 0), 0u) << e.what();
+    }
+}
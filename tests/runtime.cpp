@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "runtime.hpp"
+#include <mutex>
+#include <thread>
+
+using namespace cc;
+
+namespace {
+
+Config kCfg{2u, Time{60u}, Time{600u}, 10u};
+
+// A small but busy day; `k` varies arrival times between clubs.
+std::vector<IncomingEvent> Day(std::uint16_t k) {
+    const auto t = [k](int m) { return Time{static_cast<std::uint16_t>(m + k % 7)}; };
+    return {
+        {t(50), EventId::kClientArrived, {"early"}},
+        {t(70), EventId::kClientArrived, {"a"}},
+        {t(71), EventId::kClientSeated, {"a", "1"}},
+        {t(80), EventId::kClientArrived, {"b"}},
+        {t(81), EventId::kClientSeated, {"b", "2"}},
+        {t(90), EventId::kClientArrived, {"c"}},
+        {t(91), EventId::kClientWaiting, {"c"}},
+        {t(92), EventId::kClientSeated, {"c", "1"}},
+        {t(200), EventId::kClientLeft, {"a"}},
+        {t(300), EventId::kClientLeft, {"b"}},
+    };
+}
+
+std::vector<std::string> Sequential(const std::vector<IncomingEvent>& events,
+                                    std::vector<Table>& tables) {
+    Club club(kCfg);
+    std::vector<OutgoingEvent> log;
+    club.Run(events, log);
+    tables = club.tables();
+    std::vector<std::string> out;
+    for (const auto& e : log) out.push_back(e.time.ToString() + ' ' + e.payload);
+    return out;
+}
+
+}  // namespace
+
+TEST(Runtime, ManyClubsOnFewThreadsMatchSequentialRun) {
+    constexpr std::size_t kClubs = 500;
+    constexpr std::size_t kProducers = 4;
+
+    std::vector<std::vector<std::string>> got(kClubs);
+    std::vector<LiveClub*> clubs(kClubs);
+    {
+        Runtime rt(3);
+        for (std::size_t i = 0; i < kClubs; ++i) {
+            // Each sink is only ever called by one coroutine at a time.
+            clubs[i] = &rt.Spawn(kCfg, [&got, i](const OutgoingEvent& e) {
+                got[i].push_back(e.time.ToString() + ' ' + e.payload);
+            });
+        }
+
+        // Producers interleave pushes across their clubs.
+        std::vector<std::thread> producers;
+        for (std::size_t p = 0; p < kProducers; ++p) {
+            producers.emplace_back([&, p] {
+                std::vector<std::vector<IncomingEvent>> days;
+                for (std::size_t i = p; i < kClubs; i += kProducers)
+                    days.push_back(Day(static_cast<std::uint16_t>(i)));
+                for (std::size_t step = 0; step < days.front().size(); ++step) {
+                    for (std::size_t j = 0, i = p; i < kClubs; ++j, i += kProducers)
+                        clubs[i]->Push(days[j][step]);
+                }
+                for (std::size_t i = p; i < kClubs; i += kProducers) clubs[i]->Close();
+            });
+        }
+        for (auto& t : producers) t.join();
+        rt.Wait();
+
+        for (std::size_t i = 0; i < kClubs; ++i) {
+            std::vector<Table> tables;
+            EXPECT_EQ(got[i], Sequential(Day(static_cast<std::uint16_t>(i)), tables))
+                << "club " << i;
+            ASSERT_EQ(clubs[i]->tables().size(), tables.size());
+            for (std::size_t t = 0; t < tables.size(); ++t) {
+                EXPECT_EQ(clubs[i]->tables()[t].revenue, tables[t].revenue);
+                EXPECT_EQ(clubs[i]->tables()[t].busy_minutes, tables[t].busy_minutes);
+            }
+            EXPECT_FALSE(clubs[i]->error());
+        }
+    }
+}
+
+TEST(Runtime, LongBacklogYieldsButKeepsOrder) {
+    Runtime rt(1);
+    std::vector<std::string> seen;
+    auto& club = rt.Spawn(Config{1u, Time{0u}, Time{1439u}, 1u},
+                          [&seen](const OutgoingEvent& e) {
+                              if (e.id == EventId::kClientArrived) seen.push_back(e.payload);
+                          });
+    for (std::uint16_t m = 0; m < 1000; ++m)
+        club.Push({Time{m}, EventId::kClientArrived, {"c" + std::to_string(m)}});
+    club.Close();
+    rt.Wait();
+
+    ASSERT_EQ(seen.size(), 1000u);
+    for (std::size_t m = 0; m < seen.size(); ++m) EXPECT_EQ(seen[m], "c" + std::to_string(m));
+}
+
+TEST(Runtime, SinkFailureIsReportedAndClosesClub) {
+    Runtime rt(2);
+    auto& club = rt.Spawn(kCfg, [](const OutgoingEvent& e) {
+        if (e.id == EventId::kClientArrived) throw std::runtime_error("sink down");
+    });
+    club.Push({Time{70u}, EventId::kClientArrived, {"a"}});
+    rt.Wait();
+    EXPECT_TRUE(club.error());
+    EXPECT_THROW(club.Push({Time{71u}, EventId::kClientArrived, {"b"}}), std::logic_error);
+}
+
+TEST(Runtime, DestructorClosesOpenClubs) {
+    std::size_t lines = 0;
+    {
+        Runtime rt(2);
+        auto& club = rt.Spawn(kCfg, [&lines](const OutgoingEvent&) { ++lines; });
+        club.Push({Time{70u}, EventId::kClientArrived, {"a"}});
+    }
+    EXPECT_EQ(lines, 4u);  // open, echo, drop at close, close
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "scheduler.hpp"
+
+using namespace cc;
+
+TEST(FifoScheduler, OrderCapacityAndRemoval) {
+    FifoScheduler s(4);
+    EXPECT_TRUE(s.Enqueue("a"));
+    EXPECT_TRUE(s.Enqueue("b"));
+    EXPECT_TRUE(s.Enqueue("c"));
+    EXPECT_TRUE(s.Enqueue("a"));   // waiting again takes another slot
+    EXPECT_FALSE(s.Enqueue("d"));  // overflow
+    EXPECT_EQ(s.size(), 4u);
+
+    s.Remove("b");
+    s.Remove("nobody");
+    EXPECT_FALSE(s.Contains("b"));
+    EXPECT_EQ(s.Next(0), "a");
+    EXPECT_TRUE(s.Contains("a"));  // second slot
+    EXPECT_EQ(s.Next(0), "c");
+    EXPECT_EQ(s.Next(0), "a");
+    EXPECT_FALSE(s.Contains("a"));
+    EXPECT_EQ(s.Next(0), std::nullopt);
+}
+
+TEST(FifoScheduler, RemoveDropsEverySlot) {
+    FifoScheduler s(3);
+    s.Enqueue("a");
+    s.Enqueue("b");
+    s.Enqueue("a");
+    s.Remove("a");
+    EXPECT_EQ(s.size(), 1u);
+    EXPECT_EQ(s.Next(0), "b");
+    EXPECT_EQ(s.Next(0), std::nullopt);
+}
+
+TEST(PriorityScheduler, HigherTierFirstFifoWithinTier) {
+    PriorityScheduler s(10, {{"vip1", 2u}, {"vip2", 2u}, {"gold", 1u}});
+    for (const char* n : {"x", "gold", "vip1", "y", "vip2"}) EXPECT_TRUE(s.Enqueue(n));
+
+    s.Remove("vip1");
+    EXPECT_EQ(s.Next(0), "vip2");
+    EXPECT_EQ(s.Next(0), "gold");
+    EXPECT_EQ(s.Next(0), "x");
+    EXPECT_EQ(s.Next(0), "y");
+    EXPECT_EQ(s.Next(0), std::nullopt);
+}
+
+TEST(PriorityScheduler, RemovalKeepsHeapOrder) {
+    PriorityScheduler s(100, {});
+    for (int i = 0; i < 50; ++i) s.Enqueue("c" + std::to_string(i));
+    for (int i = 0; i < 50; i += 3) s.Remove("c" + std::to_string(i));
+    for (int i = 0; i < 50; ++i) {
+        if (i % 3 == 0) continue;
+        EXPECT_EQ(s.Next(0), "c" + std::to_string(i));
+    }
+    EXPECT_EQ(s.size(), 0u);
+}
+
+TEST(ZoneScheduler, ZonePreferenceAndSharedQueue) {
+    // Tables 0,1 in zone 0; table 2 in zone 1.
+    ZoneScheduler s(10, {0, 0, 1}, {{"quiet", 1u}, {"loud", 0u}});
+    EXPECT_TRUE(s.Enqueue("quiet"));
+    EXPECT_TRUE(s.Enqueue("anyone"));
+    EXPECT_TRUE(s.Enqueue("loud"));
+
+    EXPECT_EQ(s.Next(0), "anyone");  // earlier than "loud"
+    EXPECT_EQ(s.Next(1), "loud");
+    EXPECT_EQ(s.Next(0), std::nullopt);  // "quiet" waits for zone 1
+    EXPECT_EQ(s.Next(2), "quiet");
+}
+
+TEST(ZoneScheduler, RemoveWaitingClient) {
+    ZoneScheduler s(2, {0}, {});
+    EXPECT_TRUE(s.Enqueue("a"));
+    EXPECT_TRUE(s.Enqueue("b"));
+    EXPECT_FALSE(s.Enqueue("c"));
+    s.Remove("a");
+    EXPECT_TRUE(s.Enqueue("c"));
+    EXPECT_EQ(s.Next(0), "b");
+    EXPECT_EQ(s.Next(0), "c");
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "club.hpp"
+#include "stats_shm.hpp"
+#include <atomic>
+#include <thread>
+#include <unistd.h>
+
+using namespace cc;
+
+namespace {
+
+std::string UniqueName(const char* tag) {
+    return "/club_tracker_test_" + std::string(tag) + '_' + std::to_string(::getpid());
+}
+
+}  // namespace
+
+TEST(StatsShm, PublishedClubStateIsReadBack) {
+    const auto name = UniqueName("club");
+    Config cfg{2u, Time{0u}, Time{200u}, 10u};
+    Club club(cfg);
+    std::vector<OutgoingEvent> log;
+    club.Open(log);
+    for (const auto& ev : std::vector<IncomingEvent>{
+             {Time{10u}, EventId::kClientArrived, {"bob"}},
+             {Time{10u}, EventId::kClientSeated, {"bob", "2"}},
+             {Time{20u}, EventId::kClientArrived, {"a_name_that_is_longer_than_32_bytes"}},
+             {Time{20u}, EventId::kClientSeated, {"a_name_that_is_longer_than_32_bytes", "1"}},
+             {Time{30u}, EventId::kClientArrived, {"carol"}},
+             {Time{30u}, EventId::kClientWaiting, {"carol"}},
+             {Time{95u}, EventId::kClientLeft, {"bob"}}})
+        club.Process(ev, log);
+
+    StatsPublisher pub(name, cfg.table_count);
+    pub.Publish(club);
+
+    const auto snap = StatsReader(name).Read();
+    EXPECT_EQ(snap.version, 1u);
+    EXPECT_EQ(snap.queue_length, 0u);
+    ASSERT_EQ(snap.tables.size(), 2u);
+    EXPECT_EQ(snap.tables[0].occupant, "a_name_that_is_longer_than_32_by");
+    EXPECT_EQ(snap.tables[1].occupant, "carol");
+    EXPECT_EQ(snap.tables[1].occupied_since, Time{95u});
+    EXPECT_EQ(snap.tables[1].revenue, 20u);
+    EXPECT_EQ(snap.tables[1].busy_minutes, 85u);
+
+    EXPECT_TRUE(StatsPublisher::Remove(name));
+    EXPECT_THROW(StatsReader{name}, std::runtime_error);
+}
+
+TEST(StatsShm, ReadersNeverSeeTornSnapshots) {
+    const auto name = UniqueName("torn");
+    constexpr std::size_t kTables = 64;
+    StatsPublisher pub(name, kTables);
+    StatsReader reader(name);
+
+    std::atomic<bool> done = false;
+    std::thread writer([&] {
+        std::vector<Table> tables(kTables);
+        for (std::uint32_t round = 1; round <= 20000; ++round) {
+            // Every field of every table carries the round number.
+            for (std::size_t i = 0; i < kTables; ++i) {
+                tables[i].id = i + 1;
+                tables[i].revenue = round;
+                tables[i].busy_minutes = round;
+                tables[i].occupant = "c" + std::to_string(round);
+            }
+            pub.Publish(tables, round);
+        }
+        done = true;
+    });
+
+    while (!done) {
+        const auto snap = reader.TryRead();
+        if (!snap || snap->version == 0) continue;
+        const auto round = snap->queue_length;
+        for (const auto& t : snap->tables) {
+            ASSERT_EQ(t.revenue, round);
+            ASSERT_EQ(t.busy_minutes, round);
+            ASSERT_EQ(t.occupant, "c" + std::to_string(round));
+        }
+    }
+    writer.join();
+    EXPECT_EQ(reader.Read().queue_length, 20000u);
+    StatsPublisher::Remove(name);
+}
+
+TEST(StatsShm, ChangeHookKeepsSegmentInStepWithClub) {
+    const auto name = UniqueName("hook");
+    Config cfg{3u, Time{0u}, Time{200u}, 10u};
+    Club club(cfg);
+    StatsPublisher pub(name, cfg.table_count);
+    StatsReader reader(name);
+
+    // After every step the segment must match the club, though only the
+    // changed tables are rewritten.
+    std::size_t calls = 0;
+    club.SetChangeHook([&](const Club& c, const std::span<const std::size_t> changed) {
+        pub.Publish(c, changed);
+        ++calls;
+        const auto snap = reader.Read();
+        EXPECT_EQ(snap.version, calls);
+        EXPECT_EQ(snap.queue_length, c.queue_size());
+        const auto tables = c.tables();
+        for (std::size_t i = 0; i < tables.size(); ++i) {
+            EXPECT_EQ(snap.tables[i].occupant, tables[i].occupant) << "table " << i + 1;
+            EXPECT_EQ(snap.tables[i].occupied_since, tables[i].occupied_since);
+            EXPECT_EQ(snap.tables[i].revenue, tables[i].revenue);
+            EXPECT_EQ(snap.tables[i].busy_minutes, tables[i].busy_minutes);
+        }
+    });
+
+    const std::vector<IncomingEvent> events{
+        {Time{10u}, EventId::kClientArrived, {"bob"}},
+        {Time{10u}, EventId::kClientSeated, {"bob", "2"}},
+        {Time{20u}, EventId::kClientArrived, {"carol"}},
+        {Time{20u}, EventId::kClientSeated, {"carol", "1"}},
+        {Time{25u}, EventId::kClientArrived, {"dan"}},
+        {Time{25u}, EventId::kClientSeated, {"dan", "3"}},
+        {Time{30u}, EventId::kClientArrived, {"eve"}},
+        {Time{30u}, EventId::kClientWaiting, {"eve"}},
+        {Time{40u}, EventId::kClientSeated, {"bob", "1"}},  // PlaceIsBusy
+        {Time{95u}, EventId::kClientLeft, {"bob"}},
+    };
+    std::vector<OutgoingEvent> log;
+    club.Run(events, log);
+    EXPECT_EQ(calls, events.size() + 2);
+
+    EXPECT_TRUE(StatsPublisher::Remove(name));
+}
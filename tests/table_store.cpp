@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "table_store.hpp"
+
+using namespace cc;
+
+TEST(TableStore, OccupyReleaseAndBilling) {
+    TableStore store(3);
+    EXPECT_TRUE(store.HasFree());
+
+    store.Occupy(0, 7u, Time{10u});
+    EXPECT_TRUE(store.IsBusy(0));
+    EXPECT_EQ(store.occupant(0), 7u);
+    EXPECT_EQ(store.since(0), Time{10u});
+
+    EXPECT_EQ(store.Release(0, Time{71u}, 10u), 61u);
+    EXPECT_FALSE(store.IsBusy(0));
+    EXPECT_EQ(store.occupant(0), kNoClient);
+    EXPECT_EQ(store.revenue(0), 20u);  // 61 minutes -> 2 hours
+    EXPECT_EQ(store.busy_minutes(0), 61u);
+}
+
+TEST(TableStore, BusyBitmapAcrossWords) {
+    TableStore store(130);
+    for (std::size_t i = 0; i < 129; ++i) store.Occupy(i, static_cast<ClientId>(i), Time{0u});
+    EXPECT_TRUE(store.HasFree());
+    EXPECT_FALSE(store.IsBusy(129));
+
+    store.Occupy(129, 129u, Time{0u});
+    EXPECT_FALSE(store.HasFree());
+    EXPECT_TRUE(store.IsBusy(129));
+
+    store.Release(70, Time{5u}, 1u);
+    EXPECT_TRUE(store.HasFree());
+    EXPECT_FALSE(store.IsBusy(70));
+    EXPECT_TRUE(store.IsBusy(64));
+    EXPECT_TRUE(store.IsBusy(71));
+}
+
+TEST(TableStore, DirtyListsEachChangedTableOnce) {
+    TableStore store(130);
+    EXPECT_TRUE(store.dirty().empty());
+
+    store.Occupy(100, 1u, Time{0u});
+    store.Occupy(3, 2u, Time{0u});
+    store.Release(100, Time{10u}, 1u);
+    EXPECT_EQ(store.dirty(), (std::vector<std::size_t>{100, 3}));
+
+    store.ClearDirty();
+    EXPECT_TRUE(store.dirty().empty());
+    store.Occupy(100, 3u, Time{20u});
+    EXPECT_EQ(store.dirty(), (std::vector<std::size_t>{100}));
+}